@@ -0,0 +1,216 @@
+//  single-producer/single-consumer ringbuffer with blocking wait operations
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_BLOCKING_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_BLOCKING_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/lockfree/ringbuffer.hpp>
+#include <boost/lockfree/detail/eventcount.hpp>
+
+#include <boost/thread/thread_time.hpp>
+
+namespace boost
+{
+namespace lockfree
+{
+
+/** The blocking_ringbuffer class extends the ringbuffer with wait_enqueue and wait_dequeue operations, which spin
+ *  for a short time and then put the calling thread to sleep, until the other side changes the state of the
+ *  ringbuffer or the timeout expires.
+ *
+ *  The non-blocking operations only issue a system call, if the other side is actually sleeping. They do issue a
+ *  full memory fence though, so the plain ringbuffer should be used, if no thread needs to wait.
+ *
+ * */
+template <typename T, size_t max_size>
+class blocking_ringbuffer:
+    public ringbuffer<T, max_size>
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef ringbuffer<T, max_size> base_type;
+
+    static const int spin_count = 128;
+
+    detail::eventcount not_empty_;
+    detail::eventcount not_full_;
+
+    template <typename Operation>
+    static bool wait_for(Operation const & operation, detail::eventcount & ec, boost::posix_time::time_duration const & timeout)
+    {
+        for (int i = 0; i != spin_count; ++i) {
+            if (operation())
+                return true;
+            detail::spin_pause();
+        }
+
+        const boost::system_time deadline = boost::get_system_time() + timeout;
+        for (;;) {
+            boost::uint32_t key = ec.prepare_wait();
+            if (operation()) {
+                ec.cancel_wait();
+                return true;
+            }
+
+            const boost::posix_time::time_duration remaining = deadline - boost::get_system_time();
+            if (remaining.is_negative()) {
+                ec.cancel_wait();
+                return false;
+            }
+            ec.commit_wait(key, remaining);
+        }
+    }
+
+    struct enqueue_op
+    {
+        blocking_ringbuffer & rb;
+        T const & t;
+
+        enqueue_op(blocking_ringbuffer & rb, T const & t):
+            rb(rb), t(t)
+        {}
+
+        bool operator()(void) const
+        {
+            return rb.enqueue(t);
+        }
+    };
+
+    struct dequeue_op
+    {
+        blocking_ringbuffer & rb;
+        T * ret;
+
+        dequeue_op(blocking_ringbuffer & rb, T * ret):
+            rb(rb), ret(ret)
+        {}
+
+        bool operator()(void) const
+        {
+            return rb.dequeue(ret);
+        }
+    };
+#endif
+
+public:
+    //! Default Constructor, for static sized ringbuffer
+    blocking_ringbuffer(void)
+    {}
+
+    //! Constructs a ringbuffer for max_size elements, for run-time sized ringbuffer
+    explicit blocking_ringbuffer(size_t size):
+        base_type(size)
+    {}
+
+    /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Wakes up a consumer, which is waiting in wait_dequeue
+     * */
+    bool enqueue(T const & t)
+    {
+        if (!base_type::enqueue(t))
+            return false;
+        not_empty_.notify();
+        return true;
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     * \note Wakes up a producer, which is waiting in wait_enqueue
+     */
+    bool dequeue(T * ret)
+    {
+        if (!base_type::dequeue(ret))
+            return false;
+        not_full_.notify();
+        return true;
+    }
+
+    /** Enqueues size objects from the array t to the ringbuffer.
+     *
+     *  Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return number of enqueued items
+     *
+     * \note Wakes up a consumer, which is waiting in wait_dequeue
+     */
+    size_t enqueue(T const * t, size_t size)
+    {
+        size_t ret = base_type::enqueue(t, size);
+        if (ret)
+            not_empty_.notify();
+        return ret;
+    }
+
+    /** Dequeue a maximum of size objects from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return number of dequeued items
+     *
+     * \note Wakes up a producer, which is waiting in wait_enqueue
+     * */
+    size_t dequeue(T * ret, size_t size)
+    {
+        size_t count = base_type::dequeue(ret, size);
+        if (count)
+            not_full_.notify();
+        return count;
+    }
+
+    /** Enqueues object t to the ringbuffer. If the ringbuffer is full, waits until the consumer has dequeued an
+     *  element or the timeout expires.
+     *
+     * \return true, if the enqueue operation is successful, false if the timeout expired.
+     * */
+    bool wait_enqueue(T const & t, boost::posix_time::time_duration const & timeout)
+    {
+        return wait_for(enqueue_op(*this, t), not_full_, timeout);
+    }
+
+    /** Enqueues object t to the ringbuffer. If the ringbuffer is full, waits until the consumer has dequeued an
+     *  element.
+     * */
+    void wait_enqueue(T const & t)
+    {
+        while (!wait_enqueue(t, boost::posix_time::seconds(1)))
+        {}
+    }
+
+    /** Dequeue object from ringbuffer. If the ringbuffer is empty, waits until the producer has enqueued an element
+     *  or the timeout expires.
+     *
+     * \return true, if the dequeue operation is successful, false if the timeout expired.
+     * */
+    bool wait_dequeue(T * ret, boost::posix_time::time_duration const & timeout)
+    {
+        return wait_for(dequeue_op(*this, ret), not_empty_, timeout);
+    }
+
+    /** Dequeue object from ringbuffer. If the ringbuffer is empty, waits until the producer has enqueued an
+     *  element.
+     * */
+    void wait_dequeue(T * ret)
+    {
+        while (!wait_dequeue(ret, boost::posix_time::seconds(1)))
+        {}
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_BLOCKING_RINGBUFFER_HPP_INCLUDED */
@@ -0,0 +1,249 @@
+//  lock-free single-producer/multi-consumer broadcast ringbuffer
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_BROADCAST_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_BROADCAST_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/array.hpp>
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/smart_ptr/scoped_array.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+#include "detail/branch_hints.hpp"
+#include "detail/prefix.hpp"
+#include "detail/sequence.hpp"
+
+namespace boost
+{
+namespace lockfree
+{
+
+namespace detail
+{
+
+/* counterpart of ringbuffer_internal for one producer and several consumers. it follows the same storage convention:
+ * the derived class owns the buffer (boost::array or scoped_array) and passes it together with max_size to every
+ * operation. it cannot derive from ringbuffer_internal, because that class keeps a single read index, and its indices
+ * wrap around at max_size: the minimum of several wrapped read indices does not tell, which consumer is the slowest.
+ * therefore the positions are monotonically increasing sequences, which are reduced modulo max_size only to address a
+ * slot, and each of them is padded by padded_sequence instead of the padding members of ringbuffer_internal. */
+template <typename T>
+class broadcast_ringbuffer_internal:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+
+    padded_sequence write_sequence_; /* cached: minimum of the consumer sequences */
+    const size_t consumer_count_;
+    scoped_array<padded_sequence> read_sequences_; /* cached: write sequence, seen by the consumer */
+
+protected:
+    explicit broadcast_ringbuffer_internal(size_t consumer_count):
+        consumer_count_(consumer_count), read_sequences_(new padded_sequence[consumer_count])
+    {
+        BOOST_ASSERT(consumer_count > 0);
+    }
+
+    bool enqueue(T const & t, T * buffer, size_t max_size)
+    {
+        const size_t sequence = write_sequence_.value.load(memory_order_relaxed);
+
+        if (sequence - write_sequence_.cached >= max_size) {
+            /* only scan the consumers, if the cached gate does not leave any room */
+            write_sequence_.cached = minimum_sequence(read_sequences_.get(), consumer_count_, sequence);
+            if (sequence - write_sequence_.cached >= max_size)
+                return false; /* the slowest consumer has not released the slot, yet */
+        }
+
+        buffer[sequence % max_size] = t;
+        write_sequence_.value.store(sequence + 1, memory_order_release);
+        return true;
+    }
+
+    T const * front(size_t consumer, T const * buffer, size_t max_size)
+    {
+        BOOST_ASSERT(consumer < consumer_count_);
+        padded_sequence & reader = read_sequences_[consumer];
+        const size_t sequence = reader.value.load(memory_order_relaxed);
+
+        if (sequence == reader.cached) {
+            reader.cached = write_sequence_.value.load(memory_order_acquire);
+            if (sequence == reader.cached)
+                return 0;
+        }
+
+        return buffer + sequence % max_size;
+    }
+
+    void pop(size_t consumer)
+    {
+        BOOST_ASSERT(consumer < consumer_count_);
+        padded_sequence & reader = read_sequences_[consumer];
+        const size_t sequence = reader.value.load(memory_order_relaxed);
+
+        BOOST_ASSERT(sequence != reader.cached);
+        reader.value.store(sequence + 1, memory_order_release);
+    }
+
+    bool dequeue(size_t consumer, T * ret, T const * buffer, size_t max_size)
+    {
+        T const * element = front(consumer, buffer, max_size);
+        if (!element)
+            return false;
+
+        *ret = *element;
+        pop(consumer);
+        return true;
+    }
+#endif
+
+public:
+    //! \return number of consumers
+    size_t consumers(void) const
+    {
+        return consumer_count_;
+    }
+
+    /**
+     * \return true, if no elements are available for the consumer.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(size_t consumer)
+    {
+        BOOST_ASSERT(consumer < consumer_count_);
+        return write_sequence_.value.load(memory_order_relaxed) == read_sequences_[consumer].value.load(memory_order_relaxed);
+    }
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return write_sequence_.value.is_lock_free();
+    }
+};
+
+} /* namespace detail */
+
+/** The broadcast_ringbuffer class provides a single-writer/multi-reader ringbuffer, which delivers every element to
+ *  every consumer. Each element is written once and can be read in place by all consumers.
+ *
+ *  Consumers are identified by an index in [0, consumers()). Each consumer owns a cache-line padded read sequence,
+ *  and each consumer index must only be used by a single thread. The producer does not overwrite an element, before
+ *  the slowest consumer has released it.
+ *
+ *  Unlike the ringbuffer, whose wrapped indices leave one slot empty, the producer and consumer positions are
+ *  monotonically increasing sequences, so all max_size elements can be used.
+ *
+ * */
+template <typename T, size_t max_size>
+class broadcast_ringbuffer:
+    public detail::broadcast_ringbuffer_internal<T>
+{
+    typedef std::size_t size_t;
+    typedef detail::broadcast_ringbuffer_internal<T> base_type;
+    boost::array<T, max_size> array_;
+
+public:
+    //! Constructs a ringbuffer for the given number of consumers
+    explicit broadcast_ringbuffer(size_t consumers):
+        base_type(consumers)
+    {}
+
+    /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the slowest consumer has not released the oldest
+     *  element.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool enqueue(T const & t)
+    {
+        return base_type::enqueue(t, array_.c_array(), max_size);
+    }
+
+    /** Dequeue object from ringbuffer for the given consumer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if no element is available for the consumer.
+     *
+     */
+    bool dequeue(size_t consumer, T * ret)
+    {
+        return base_type::dequeue(consumer, ret, array_.data(), max_size);
+    }
+
+    /** Zero-copy access to the next element for the given consumer.
+     *
+     * \return pointer to the element, or NULL, if no element is available. The element stays valid until pop is
+     *         called by the same consumer.
+     * */
+    T const * front(size_t consumer)
+    {
+        return base_type::front(consumer, array_.data(), max_size);
+    }
+
+    /** Releases the element returned by front.
+     *
+     * \pre front has returned a non-NULL pointer for this consumer
+     * */
+    void pop(size_t consumer)
+    {
+        base_type::pop(consumer);
+    }
+};
+
+template <typename T>
+class broadcast_ringbuffer<T, 0>:
+    public detail::broadcast_ringbuffer_internal<T>
+{
+    typedef std::size_t size_t;
+    typedef detail::broadcast_ringbuffer_internal<T> base_type;
+    size_t max_size_;
+    scoped_array<T> array_;
+
+public:
+    //! Constructs a ringbuffer for max_size elements and the given number of consumers
+    broadcast_ringbuffer(size_t max_size, size_t consumers):
+        base_type(consumers), max_size_(max_size), array_(new T[max_size])
+    {}
+
+    //! \copydoc boost::lockfree::broadcast_ringbuffer::enqueue
+    bool enqueue(T const & t)
+    {
+        return base_type::enqueue(t, array_.get(), max_size_);
+    }
+
+    //! \copydoc boost::lockfree::broadcast_ringbuffer::dequeue
+    bool dequeue(size_t consumer, T * ret)
+    {
+        return base_type::dequeue(consumer, ret, array_.get(), max_size_);
+    }
+
+    //! \copydoc boost::lockfree::broadcast_ringbuffer::front
+    T const * front(size_t consumer)
+    {
+        return base_type::front(consumer, array_.get(), max_size_);
+    }
+
+    //! \copydoc boost::lockfree::broadcast_ringbuffer::pop
+    void pop(size_t consumer)
+    {
+        base_type::pop(consumer);
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_BROADCAST_RINGBUFFER_HPP_INCLUDED */
@@ -0,0 +1,87 @@
+//  lock-free fifo queue with a small per-queue footprint, based on
+//  Michael, M. M. and Scott, M. L.,
+//  "simple, fast and practical non-blocking and blocking concurrent queue algorithms"
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_COMPACT_FIFO_HPP_INCLUDED
+#define BOOST_LOCKFREE_COMPACT_FIFO_HPP_INCLUDED
+
+#include <boost/lockfree/fifo.hpp>
+
+namespace boost
+{
+namespace lockfree
+{
+
+namespace detail
+{
+
+/* process-wide pool of the compact_fifos, which use a node_pool of type Pool. it is keyed on the pool type, so fifos
+ * with different value types of the same size and alignment share it. constructed by the constructor of the first
+ * compact_fifo, which uses it, so it is destroyed after all compact_fifos with static storage duration */
+template <typename Pool>
+struct default_node_pool
+{
+    static Pool & get(void)
+    {
+        static Pool pool;
+        return pool;
+    }
+};
+
+} /* namespace detail */
+
+/** The compact_fifo class provides a multi-writer/multi-reader fifo for applications, which use a large number of
+ *  mostly empty queues, e.g. one queue per connection.
+ *
+ *  It is a fifo with packed nodes and the shared_freelist_t policy, but it does not pad head and tail to separate
+ *  cache lines and it only allocates its dummy node, when the first element is enqueued. Its nodes are drawn from a
+ *  node_pool, which is passed to the constructor and can be shared with other containers of the same value size. The
+ *  default constructor uses a process-wide pool, which is shared by all default-constructed compact_fifo instances,
+ *  whose value types have the same size and alignment, e.g. compact_fifo<int> and compact_fifo<float>.
+ *
+ *  A compact_fifo occupies two tagged pointers and a reference to its pool, i.e. 24 bytes on platforms with pointer
+ *  compression like x86_64 and 40 bytes on platforms, which use double-width compare-and-swap. After the first element
+ *  has been enqueued, it additionally holds one dummy node from the pool.
+ *
+ *  The pool grows on demand and never returns memory to the operating system before it is destroyed. The process-wide
+ *  pool is destroyed after all compact_fifo instances with static storage duration, which use it.
+ *
+ *  \b Limitation: The compact_fifo class is limited to PODs. Head and tail may share a cache line, so a contended
+ *  compact_fifo is slower than a fifo.
+ *
+ * */
+template <typename T>
+class compact_fifo:
+    public detail::fifo<T, detail::container_policies<T, shared_freelist_t, detail::compact_layout_t> >
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef detail::fifo<T, detail::container_policies<T, shared_freelist_t, detail::compact_layout_t> > fifo_t;
+#endif
+
+public:
+    //! Construct fifo, which allocates its nodes from the process-wide pool. Does not allocate any memory.
+    compact_fifo(void):
+        fifo_t(detail::default_node_pool<typename fifo_t::pool_type>::get())
+    {}
+
+    /** Construct fifo, which allocates its nodes from a shared node pool. Does not allocate any memory.
+     *
+     * \pre the pool outlives the fifo
+     * */
+    explicit compact_fifo(typename fifo_t::pool_type & pool):
+        fifo_t(pool)
+    {}
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_COMPACT_FIFO_HPP_INCLUDED */
@@ -19,15 +19,24 @@
 #define HPX_F985C12D_03E7_4E25_8CB1_018A56A265E0
 
 #include <iostream>
+#include <stdexcept>
 #include <boost/thread/thread.hpp>
 
 #include <boost/config.hpp>
-#include <boost/atomic.hpp>
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/mpl/identity.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
 
+#include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/detail/tagged_index.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 #include <boost/lockfree/detail/tagged_ptr_pair.hpp>
+#include <boost/lockfree/policies.hpp>
 
 namespace boost { namespace lockfree
 {
@@ -45,7 +54,7 @@ template <typename T>
 struct deque_node
 {
     typedef tagged_ptr<deque_node> pointer;
-    typedef atomic<pointer> atomic_pointer;
+    typedef detail::atomic<pointer> atomic_pointer;
     
     typedef typename pointer::tag_t tag_t;
 
@@ -61,6 +70,48 @@ struct deque_node
     deque_node(deque_node* lptr, deque_node* rptr, T const& v,
                tag_t ltag = 0, tag_t rtag = 0):
         left(pointer(lptr, ltag)), right(pointer(rptr, rtag)), data(v) {}
+
+    deque_node(pointer const& l, pointer const& r, T const& v):
+        left(l), right(r), data(v) {}
+};
+
+// Node of deques with the indexed_freelist_t policy. The links are tagged
+// indices into the indexed freelist of the deque, so they fit into 64 bits
+// even on targets, where a tagged pointer needs a double-width CAS.
+template <typename T, typename Link>
+struct indexed_deque_node
+{
+    typedef Link pointer;
+    typedef detail::atomic<pointer> atomic_pointer;
+
+    typedef typename pointer::tag_t tag_t;
+
+    atomic_pointer left;
+    atomic_pointer right;
+    T data;
+
+    indexed_deque_node(pointer const& l, pointer const& r, T const& v):
+        left(l), right(r), data(v) {}
+};
+
+template <std::size_t N>
+struct indexed_deque_bit_width
+{ BOOST_STATIC_CONSTANT(int, value = 1 + indexed_deque_bit_width<N / 2>::value); };
+
+template <>
+struct indexed_deque_bit_width<0>
+{ BOOST_STATIC_CONSTANT(int, value = 0); };
+
+// Width of the node indices of an indexed deque. The indices are as narrow as
+// the capacity policy allows, which leaves more bits for the ABA tag of the
+// anchor. Without a capacity policy, the indices have 16 bits. Capacities
+// above 2^21 - 1 are rejected by the deque.
+template <std::size_t Capacity>
+struct indexed_deque_index_bits
+{
+    BOOST_STATIC_CONSTANT(int, width = indexed_deque_bit_width<Capacity>::value);
+    BOOST_STATIC_CONSTANT(int, value =
+        Capacity == 0 ? 16 : (width > 21 ? 21 : width));
 };
 
 // FIXME: A lot of these methods can be dropped; in fact, it may make sense to
@@ -75,7 +126,10 @@ struct deque_anchor
     typedef typename node::tag_t tag_t;
   
     typedef tagged_ptr_pair<node, node> pair;
-    typedef atomic<pair> atomic_pair;
+    typedef detail::atomic<pair> atomic_pair;
+
+    // Tagged pointers can refer to any number of nodes.
+    BOOST_STATIC_CONSTANT(std::size_t, max_nodes = ~std::size_t(0));
 
   private:
     atomic_pair pair_;
@@ -83,6 +137,10 @@ struct deque_anchor
   public:
     deque_anchor(): pair_(pair(0, 0, stable, 0)) {}
 
+    // The anchor does not need the node pool of the deque.
+    template <typename Pool>
+    explicit deque_anchor(Pool const&): pair_(pair(0, 0, stable, 0)) {}
+
     deque_anchor(deque_anchor const& p): pair_(p.pair_.load()) {}
     
     deque_anchor(pair const& p): pair_(p) {}
@@ -91,8 +149,9 @@ struct deque_anchor
                  tag_t status = stable, tag_t tag = 0):
         pair_(pair(lptr, rptr, status, tag)) {}
 
+    // Acquires the nodes published by the CAS, which installed the anchor.
     pair lrs() const volatile
-    { return pair_.load(); }        
+    { return pair_.load(memory_order_acquire); }        
 
     node* left() const volatile
     { return pair_.load().get_left_ptr(); }        
@@ -115,8 +174,13 @@ struct deque_anchor
     bool cas(deque_anchor& expected, pair const& desired) volatile
     { return pair_.compare_exchange_strong(expected.load(), desired); }
 
+    // Releases the nodes, which have been linked before, and acquires the
+    // nodes, which are popped.
     bool cas(pair& expected, pair const& desired) volatile
-    { return pair_.compare_exchange_strong(expected, desired); }
+    {
+        return pair_.compare_exchange_strong(expected, desired,
+            memory_order_acq_rel, memory_order_acquire);
+    }
 
     bool operator==(volatile deque_anchor const& rhs) const 
     { return pair_.load() == rhs.pair_.load(); }
@@ -125,7 +189,7 @@ struct deque_anchor
     { return !(*this == rhs); }
     
     bool operator==(volatile pair const& rhs) const 
-    { return pair_.load() == rhs; }
+    { return pair_.load(memory_order_acquire) == rhs; }
     
     bool operator!=(volatile pair const& rhs) const 
     { return !(*this == rhs); }
@@ -134,45 +198,216 @@ struct deque_anchor
     { return pair_.is_lock_free(); }
 };
 
-// TODO: Experiment with memory ordering to see where we can optimize without
-// breaking things.
+// Anchor of deques with the indexed_freelist_t policy. Instead of two tagged
+// pointers, the indices of the leftmost and rightmost nodes in the indexed
+// freelist of the deque are packed into a single 64-bit word together with
+// the status and the ABA tag, so a single-width CAS is sufficient:
+//
+//   left index | right index | status (2 bits) | tag
+//
+// The indices are IndexBits wide, the tag takes the remaining 62 - 2*IndexBits
+// bits. With the default of 16-bit indices, the tag has 30 bits and the deque
+// holds at most 2^16 - 1 nodes. Narrower indices widen the tag, which wraps
+// around after 2^tag_bits CASes of the anchor.
+template <typename Node, typename Pool, int IndexBits>
+struct indexed_deque_anchor
+{
+    typedef Node node;
+    typedef boost::uint64_t tag_t;
+    typedef boost::uint64_t word;
+
+    BOOST_STATIC_CONSTANT(int, tag_bits = 62 - 2 * IndexBits);
+    BOOST_STATIC_CONSTANT(int, status_shift = tag_bits);
+    BOOST_STATIC_CONSTANT(int, right_shift = tag_bits + 2);
+    BOOST_STATIC_CONSTANT(int, left_shift = tag_bits + 2 + IndexBits);
+
+    BOOST_STATIC_CONSTANT(word, index_mask = (word(1) << IndexBits) - 1);
+    BOOST_STATIC_CONSTANT(word, status_mask = 0x3);
+    BOOST_STATIC_CONSTANT(word, tag_mask = (word(1) << tag_bits) - 1);
+
+    // 21-bit indices leave the narrowest tag, 20 bits.
+    BOOST_STATIC_ASSERT(IndexBits > 0 && tag_bits >= 20);
+
+    // Index 0 denotes the null pointer.
+    BOOST_STATIC_CONSTANT(std::size_t, max_nodes = index_mask);
+
+    // Unpacked anchor, provides the interface of tagged_ptr_pair.
+    struct pair
+    {
+        template <typename IntegralL, typename IntegralR>
+        pair(node* lptr, node* rptr, IntegralL status, IntegralR tag):
+            left_(lptr), right_(rptr), status_(tag_t(status) & status_mask),
+            tag_(tag_t(tag) & tag_mask) {}
+
+        node* get_left_ptr() const
+        { return left_; }
+
+        node* get_right_ptr() const
+        { return right_; }
+
+        tag_t get_left_tag() const
+        { return status_; }
+
+        tag_t get_right_tag() const
+        { return tag_; }
+
+      private:
+        node* left_;
+        node* right_;
+        tag_t status_;
+        tag_t tag_;
+    };
+
+  private:
+    detail::atomic<word> word_;
+    Pool const* pool_;
+
+    word pack(pair const& p) const
+    {
+        // The deque rejects pools with more than max_nodes nodes.
+        word left = pool_->get_index(p.get_left_ptr());
+        word right = pool_->get_index(p.get_right_ptr());
+        BOOST_ASSERT(left <= index_mask && right <= index_mask);
+
+        return (left << left_shift) | (right << right_shift)
+             | (word(p.get_left_tag()) << status_shift)
+             | word(p.get_right_tag());
+    }
+
+    pair unpack(word w) const
+    {
+        typedef typename Pool::index_t index_t;
+        return pair(pool_->pointer(index_t((w >> left_shift) & index_mask)),
+                    pool_->pointer(index_t((w >> right_shift) & index_mask)),
+                    (w >> status_shift) & status_mask, w & tag_mask);
+    }
+
+  public:
+    // The pool has to outlive the anchor.
+    explicit indexed_deque_anchor(Pool const& pool):
+        word_(0), pool_(&pool) {}
+
+    pair lrs() const
+    { return unpack(word_.load(memory_order_acquire)); }
+
+    bool cas(pair& expected, pair const& desired)
+    {
+        word old = pack(expected);
+        if (word_.compare_exchange_strong(old, pack(desired),
+                memory_order_acq_rel, memory_order_acquire))
+            return true;
+        expected = unpack(old);
+        return false;
+    }
+
+    bool operator==(pair const& rhs) const
+    { return word_.load(memory_order_acquire) == pack(rhs); }
+
+    bool operator!=(pair const& rhs) const
+    { return !(*this == rhs); }
+
+    bool is_lock_free() const
+    { return word_.is_lock_free(); }
+};
+
+// Memory ordering: nodes are published and retired exclusively through the
+// anchor, so anchor loads are acquire and anchor CASes are acq_rel. The links
+// of a new node are stored relaxed before the CAS, which publishes the node.
+// Links are loaded with acquire semantics, so they cannot be reordered after
+// the anchor load, which validates them. The link CAS in stabilize_left and
+// stabilize_right can be relaxed, because other threads only rely on the
+// fixed link after they have observed the subsequent stable anchor.
+//
+// The deque is configured by up to four policy arguments in any order, see
+// the fifo class: a freelist policy (caching_freelist_t, static_freelist_t,
+// shared_freelist_t, indexed_freelist_t or fixed_sized<>), capacity<N>,
+// allocator<Alloc> and backoff<Backoff>. The positional form
+// deque<T, freelist_t, Alloc> is still accepted.
 template <typename T,
-          typename freelist_t = caching_freelist_t,
-          typename Alloc = std::allocator<T>
+          typename A0 = detail::no_policy,
+          typename A1 = detail::no_policy,
+          typename A2 = detail::no_policy,
+          typename A3 = detail::no_policy
           >
 struct deque: private boost::noncopyable
 {
-    typedef deque_node<T> node;
+    typedef detail::container_policies<T, A0, A1, A2, A3> policies;
+    typedef typename policies::freelist_t freelist_t;
+    typedef typename policies::allocator_t Alloc;
+    typedef typename policies::backoff_t backoff_t;
+
+    BOOST_STATIC_CONSTANT(bool, indexed =
+        (boost::is_same<freelist_t, indexed_freelist_t>::value));
+    BOOST_STATIC_CONSTANT(int, index_bits =
+        indexed_deque_index_bits<policies::capacity>::value);
+
+    // With the indexed_freelist_t policy, the links are tagged indices.
+    typedef typename boost::mpl::if_c<indexed,
+        indexed_deque_node<T, typename detail::select_tagged_index<
+            (std::size_t(1) << index_bits) - 1
+        >::link_type>,
+        deque_node<T>
+    >::type node;
     typedef typename node::pointer node_pointer;
     typedef typename node::atomic_pointer atomic_node_pointer;
 
     typedef typename node::tag_t tag_t;
   
-    typedef deque_anchor<T> anchor;
-    typedef typename anchor::pair anchor_pair;
-    typedef typename anchor::atomic_pair atomic_anchor_pair;
-
     typedef typename Alloc::template rebind<node>::other node_allocator;
 
-    typedef typename boost::mpl::if_<
-        boost::is_same<freelist_t, caching_freelist_t>,
-        caching_freelist<node, node_allocator>,
-        static_freelist<node, node_allocator>
+    // node_pool, which can be shared by deques, fifos and stacks with the
+    // shared_freelist_t policy and the same value size.
+    typedef typename detail::shared_pool<T>::type pool_type;
+
+    typedef typename detail::select_freelist<
+        node, node_allocator, freelist_t, pool_type
     >::type pool;
 
+    // With the indexed_freelist_t policy, the anchor fits into 64 bits.
+    typedef typename boost::mpl::if_c<indexed,
+        indexed_deque_anchor<node, pool, index_bits>,
+        deque_anchor<T>
+    >::type anchor;
+    typedef typename anchor::pair anchor_pair;
+
   private:
-    anchor anchor_;
+    BOOST_STATIC_ASSERT(policies::capacity <= anchor::max_nodes);
+
+    // The indexed anchor refers to the pool, so the pool is constructed
+    // first.
     pool pool_;
+    anchor anchor_;
  
     BOOST_STATIC_CONSTANT(int,
         padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(anchor));
     char padding[padding_size];
 
+    // Links are tagged pointers or tagged indices into the indexed freelist.
+    node* get_ptr(tagged_ptr<node> const& p) const
+    { return p.get_ptr(); }
+
+    template <typename Index, typename Tag>
+    node* get_ptr(detail::tagged_index<Index, Tag> const& p) const
+    { return pool_.pointer(p.get_index()); }
+
+    node_pointer make_pointer(node* n, tag_t tag = 0) const
+    { return make_pointer(n, tag, static_cast<node_pointer*>(0)); }
+
+    node_pointer make_pointer(node* n, tag_t tag, tagged_ptr<node>*) const
+    { return node_pointer(n, tag); }
+
+    template <typename Index, typename Tag>
+    node_pointer make_pointer(node* n, tag_t tag,
+                              detail::tagged_index<Index, Tag>*) const
+    { return node_pointer(Index(pool_.get_index(n)), tag); }
+
     node* alloc_node(node* lptr, node* rptr, T const& v,
                      tag_t ltag = 0, tag_t rtag = 0)
     {
         node* chunk = pool_.allocate();
-        new (chunk) node(lptr, rptr, v, ltag, rtag);
+        if (chunk == 0)
+            return 0;
+        new (chunk) node(make_pointer(lptr, ltag), make_pointer(rptr, rtag), v);
         return chunk;
     }
 
@@ -182,29 +417,39 @@ struct deque: private boost::noncopyable
         pool_.deallocate(n);
     }
     
+    // Used in the initializer list, before the pool allocates the nodes.
+    static std::size_t check_capacity(std::size_t nodes)
+    {
+        if (nodes > anchor::max_nodes)
+            throw std::length_error("boost::lockfree::deque: "
+                "too many nodes for the indices of an indexed deque");
+        return nodes;
+    }
+
     void stabilize_left(anchor_pair& lrs)
     { 
         // Get the right node of the leftmost pointer held by lrs and it's ABA
         // tag (tagged_ptr). 
-        node_pointer prev = lrs.get_left_ptr()->right.load();
+        node_pointer prev = lrs.get_left_ptr()->right.load(memory_order_acquire);
 
         if (anchor_ != lrs)
             return;
 
         // Get the left node of prev and it's tag (again, a tuple represented by
         // a tagged_ptr).
-        node_pointer prevnext = prev.get_ptr()->left.load();
+        node_pointer prevnext = get_ptr(prev)->left.load(memory_order_acquire);
 
         // Check if prevnext is equal to r.
-        if (prevnext.get_ptr() != lrs.get_left_ptr())
+        if (get_ptr(prevnext) != lrs.get_left_ptr())
         {
             if (anchor_ != lrs)  
                 return;
 
             // Attempt the CAS, incrementing the tag to protect from the ABA
             // problem.
-            if (!prev.get_ptr()->left.compare_exchange_strong(prevnext,
-                     node_pointer(lrs.get_left_ptr(), prevnext.get_tag() + 1)))
+            if (!get_ptr(prev)->left.compare_exchange_strong(prevnext,
+                     make_pointer(lrs.get_left_ptr(), prevnext.get_tag() + 1),
+                     memory_order_relaxed, memory_order_relaxed))
                 return;
         }
         // Try to update the anchor, modifying the status and ABA tag.
@@ -216,25 +461,26 @@ struct deque: private boost::noncopyable
     {
         // Get the left node of the rightmost pointer held by lrs and it's ABA
         // tag (tagged_ptr). 
-        node_pointer prev = lrs.get_right_ptr()->left.load();
+        node_pointer prev = lrs.get_right_ptr()->left.load(memory_order_acquire);
 
         if (anchor_ != lrs)
             return;
 
         // Get the right node of prev and it's tag (again, a tuple represented
         // by a tagged_ptr).
-        node_pointer prevnext = prev.get_ptr()->right.load();
+        node_pointer prevnext = get_ptr(prev)->right.load(memory_order_acquire);
 
         // Check if prevnext is equal to r.
-        if (prevnext.get_ptr() != lrs.get_right_ptr())
+        if (get_ptr(prevnext) != lrs.get_right_ptr())
         {
             if (anchor_ != lrs)  
                 return;
 
             // Attempt the CAS, incrementing the tag to protect from the ABA
             // problem.
-            if (!prev.get_ptr()->right.compare_exchange_strong(prevnext,
-                     node_pointer(lrs.get_right_ptr(), prevnext.get_tag() + 1)))
+            if (!get_ptr(prev)->right.compare_exchange_strong(prevnext,
+                     make_pointer(lrs.get_right_ptr(), prevnext.get_tag() + 1),
+                     memory_order_relaxed, memory_order_relaxed))
                 return;
         }
         // Try to update the anchor, modifying the status and ABA tag.
@@ -252,7 +498,22 @@ struct deque: private boost::noncopyable
     }
     
   public:
-    deque(std::size_t initial_nodes = 128): anchor_(), pool_(initial_nodes) {}
+    // Allocates 128 nodes, or capacity nodes, if the capacity policy is
+    // given.
+    deque():
+        pool_(policies::has_capacity ? policies::capacity : 128),
+        anchor_(pool_) {}
+
+    // With the static_freelist_t and indexed_freelist_t policies,
+    // initial_nodes is the capacity of the deque. Throws std::length_error,
+    // if an indexed deque would exceed anchor::max_nodes nodes.
+    deque(std::size_t initial_nodes):
+        pool_(check_capacity(initial_nodes)), anchor_(pool_) {}
+
+    // Allocates nodes from a shared node pool, which has to outlive the deque.
+    // Requires the shared_freelist_t policy.
+    explicit deque(pool_type& shared_pool):
+        pool_(shared_pool), anchor_(pool_) {}
 
     // Not thread-safe.
     // Complexity: O(N*Processes)
@@ -278,7 +539,10 @@ struct deque: private boost::noncopyable
     // Thread-safe and non-blocking.
     // Complexity: O(1)
     bool is_lock_free() const
-    { return anchor_.is_lock_free(); }
+    {
+        atomic_node_pointer link(make_pointer(0));
+        return anchor_.is_lock_free() && link.is_lock_free();
+    }
 
     // Thread-safe and non-blocking (may block if node needs to be allocated
     // from the operating system). Returns false if the freelist is not able to
@@ -292,6 +556,8 @@ struct deque: private boost::noncopyable
         if (n == 0)
             return false;
 
+        backoff_t backoff;
+
         // Loop until we insert successfully.
         while (true)
         { 
@@ -308,6 +574,8 @@ struct deque: private boost::noncopyable
                 if (anchor_.cas(lrs, anchor_pair(n, n,
                         lrs.get_left_tag(), lrs.get_right_tag() + 1)))
                     return true; 
+
+                backoff();
             }
 
             // Check if the deque is stable.
@@ -315,7 +583,8 @@ struct deque: private boost::noncopyable
             { 
                 // Make the right pointer on our new node refer to the current
                 // leftmost node.
-                n->right.store(node_pointer(lrs.get_left_ptr()));
+                n->right.store(make_pointer(lrs.get_left_ptr()),
+                    memory_order_relaxed);
 
                 // Now we want to make the anchor point to our new node as the
                 // leftmost node. We change the state to lpush as the deque
@@ -328,10 +597,13 @@ struct deque: private boost::noncopyable
                     stabilize_left(new_anchor);
                     return true;
                 }
+
+                backoff();
             }
 
             // The deque must be unstable, so we have to stabilize it before
-            // we can continue.
+            // we can continue. Stabilizing makes progress, so we do not back
+            // off.
             else // lrs.s() != stable
                 stabilize(lrs);
         }
@@ -349,6 +621,8 @@ struct deque: private boost::noncopyable
         if (n == 0)
             return false;
 
+        backoff_t backoff;
+
         // Loop until we insert successfully.
         while (true)
         { 
@@ -365,6 +639,8 @@ struct deque: private boost::noncopyable
                 if (anchor_.cas(lrs, anchor_pair(n, n,
                         lrs.get_left_tag(), lrs.get_right_tag() + 1)))
                     return true; 
+
+                backoff();
             }
 
             // Check if the deque is stable.
@@ -372,7 +648,8 @@ struct deque: private boost::noncopyable
             { 
                 // Make the left pointer on our new node refer to the current
                 // rightmost node.
-                n->left.store(node_pointer(lrs.get_right_ptr()));
+                n->left.store(make_pointer(lrs.get_right_ptr()),
+                    memory_order_relaxed);
 
                 // Now we want to make the anchor point to our new node as the
                 // leftmost node. We change the state to lpush as the deque
@@ -385,10 +662,13 @@ struct deque: private boost::noncopyable
                     stabilize_right(new_anchor);
                     return true;
                 }
+
+                backoff();
             }
 
             // The deque must be unstable, so we have to stabilize it before
-            // we can continue.
+            // we can continue. Stabilizing makes progress, so we do not back
+            // off.
             else // lrs.s() != stable
                 stabilize(lrs);
         }
@@ -398,6 +678,8 @@ struct deque: private boost::noncopyable
     // Complexity: O(Processes)
     bool pop_left(T& r)
     { 
+        backoff_t backoff;
+
         // Loop until we either pop an element or learn that the deque is empty.
         while (true)
         { 
@@ -421,6 +703,8 @@ struct deque: private boost::noncopyable
                     dealloc_node(lrs.get_left_ptr());
                     return true;
                 }
+
+                backoff();
             }
 
             // Check if the deque is stable.
@@ -431,11 +715,11 @@ struct deque: private boost::noncopyable
                     continue;
 
                 // Get the leftmost nodes' right node.
-                node_pointer prev = lrs.get_left_ptr()->right.load();
+                node_pointer prev = lrs.get_left_ptr()->right.load(memory_order_acquire);
                
                 // Try to update the anchor to point to prev as the leftmost
                 // node.
-                if (anchor_.cas(lrs, anchor_pair(prev.get_ptr(),
+                if (anchor_.cas(lrs, anchor_pair(get_ptr(prev),
                         lrs.get_right_ptr(), lrs.get_left_tag(),
                         lrs.get_right_tag() + 1)))
                 {
@@ -444,10 +728,13 @@ struct deque: private boost::noncopyable
                     dealloc_node(lrs.get_left_ptr());
                     return true;
                 }
+
+                backoff();
             }
 
             // The deque must be unstable, so we have to stabilize it before
-            // we can continue.
+            // we can continue. Stabilizing makes progress, so we do not back
+            // off.
             else // lrs.s() != stable
                 stabilize(lrs);
         }
@@ -459,6 +746,8 @@ struct deque: private boost::noncopyable
     // Complexity: O(Processes)
     bool pop_right(T& r)
     { 
+        backoff_t backoff;
+
         // Loop until we either pop an element or learn that the deque is empty.
         while (true)
         { 
@@ -482,6 +771,8 @@ struct deque: private boost::noncopyable
                     dealloc_node(lrs.get_right_ptr());
                     return true;
                 }
+
+                backoff();
             }
 
             // Check if the deque is stable.
@@ -492,12 +783,12 @@ struct deque: private boost::noncopyable
                     continue;
 
                 // Get the rightmost nodes' left node.
-                node_pointer prev = lrs.get_right_ptr()->left.load();
+                node_pointer prev = lrs.get_right_ptr()->left.load(memory_order_acquire);
                
                 // Try to update the anchor to point to prev as the rightmost
                 // node.
                 if (anchor_.cas(lrs, anchor_pair(lrs.get_left_ptr(),
-                        prev.get_ptr(), lrs.get_left_tag(),
+                        get_ptr(prev), lrs.get_left_tag(),
                         lrs.get_right_tag() + 1)))
                 {
                     // Set the result, deallocate the popped node, and return.
@@ -505,16 +796,112 @@ struct deque: private boost::noncopyable
                     dealloc_node(lrs.get_right_ptr());
                     return true;
                 }
+
+                backoff();
             }
 
             // The deque must be unstable, so we have to stabilize it before
-            // we can continue.
+            // we can continue. Stabilizing makes progress, so we do not back
+            // off.
             else // lrs.s() != stable
                 stabilize(lrs);
         }
     } 
     
     bool pop_right(T* r) { return pop_right(*r); }
+
+    // Thread-safe and non-blocking. Removes the leftmost ceil(N/2) elements
+    // (but at most max_count) of the N elements of the deque with a single CAS
+    // of the anchor, and writes them to r in left-to-right order. Intended
+    // for thieves of a work-stealing scheduler, whose victim pushes and pops
+    // on the right. Returns the number of removed elements, 0 if the deque is
+    // empty.
+    // Complexity: O(max_count*Processes)
+    std::size_t steal_half(T* r, std::size_t max_count)
+    {
+        if (max_count == 0)
+            return 0;
+
+        backoff_t backoff;
+
+        // Loop until we either detach a batch or learn that the deque is empty.
+        while (true)
+        {
+            // Load the anchor.
+            anchor_pair lrs = anchor_.lrs();
+
+            // Check if the deque is empty.
+            if (lrs.get_left_ptr() == 0)
+                return 0;
+
+            // The links between the leftmost and the rightmost node are only
+            // consistent if the deque is stable.
+            if (lrs.get_left_tag() != stable)
+            {
+                stabilize(lrs);
+                continue;
+            }
+
+            // Find the middle node: last advances one node, while probe
+            // advances two nodes towards the rightmost node. If the anchor
+            // changes during the walk, the nodes may have been popped, so we
+            // stop at null links and let the CAS below fail.
+            node* last = lrs.get_left_ptr();
+            node* probe = last;
+            std::size_t count = 1;
+            bool inconsistent = false;
+
+            while (count != max_count && probe != lrs.get_right_ptr())
+            {
+                node* next = get_ptr(probe->right.load(memory_order_acquire));
+                if (next == lrs.get_right_ptr())
+                    break;
+
+                if (next == 0 || (probe = get_ptr(next->right.load(memory_order_acquire))) == 0)
+                {
+                    inconsistent = true;
+                    break;
+                }
+
+                last = get_ptr(last->right.load(memory_order_acquire));
+                ++count;
+            }
+
+            if (inconsistent)
+                continue;
+
+            // Detach the leftmost count nodes. If last is the rightmost node,
+            // the deque becomes empty.
+            node* new_left = 0;
+            node* new_right = 0;
+
+            if (last != lrs.get_right_ptr())
+            {
+                new_left = get_ptr(last->right.load(memory_order_acquire));
+                new_right = lrs.get_right_ptr();
+                if (new_left == 0)
+                    continue;
+            }
+
+            if (anchor_.cas(lrs, anchor_pair(new_left, new_right,
+                    lrs.get_left_tag(), lrs.get_right_tag() + 1)))
+            {
+                // The detached nodes are owned by us now, copy the results
+                // and deallocate the nodes.
+                node* n = lrs.get_left_ptr();
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    node* next = get_ptr(n->right.load(memory_order_acquire));
+                    r[i] = n->data;
+                    dealloc_node(n);
+                    n = next;
+                }
+                return count;
+            }
+
+            backoff();
+        }
+    }
 };
 
 }}
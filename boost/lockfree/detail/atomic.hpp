@@ -0,0 +1,370 @@
+//  atomic backend
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_DETAIL_ATOMIC_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_ATOMIC_HPP_INCLUDED
+
+/* this file defines the following macros:
+   BOOST_LOCKFREE_STD_ATOMIC:    atomics are implemented with std::atomic. defined for c++11 compilers, unless
+                                 BOOST_LOCKFREE_USE_BOOST_ATOMIC is defined
+   BOOST_LOCKFREE_DCAS_BUILTIN:  16 byte atomics are implemented with the gcc __sync builtins, which inline
+                                 cmpxchg16b. requires -mcx16 on x86_64
+
+   it honors the following macros:
+   BOOST_LOCKFREE_USE_BOOST_ATOMIC:      use Boost.Atomic even if std::atomic is available
+   BOOST_LOCKFREE_ALLOW_BLOCKING_ATOMICS: do not reject atomics, which are implemented with locks
+*/
+
+#include <boost/atomic.hpp>
+#include <boost/config.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/static_assert.hpp>
+
+#include <cstring>
+
+#if !defined(BOOST_LOCKFREE_USE_BOOST_ATOMIC) && (__cplusplus >= 201103L) \
+    && !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_NO_0X_HDR_ATOMIC)
+#define BOOST_LOCKFREE_STD_ATOMIC
+#include <atomic>
+#endif
+
+#if defined(__GNUC__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define BOOST_LOCKFREE_DCAS_BUILTIN
+#endif
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+/* the containers always use the memory_order constants of Boost.Atomic, they are translated for the backend */
+#ifdef BOOST_LOCKFREE_STD_ATOMIC
+typedef std::memory_order backend_memory_order;
+
+inline std::memory_order to_backend(memory_order order)
+{
+    switch (order) {
+    case memory_order_relaxed:
+        return std::memory_order_relaxed;
+    case memory_order_consume:
+        return std::memory_order_consume;
+    case memory_order_acquire:
+        return std::memory_order_acquire;
+    case memory_order_release:
+        return std::memory_order_release;
+    case memory_order_acq_rel:
+        return std::memory_order_acq_rel;
+    default:
+        return std::memory_order_seq_cst;
+    }
+}
+
+inline void atomic_thread_fence(memory_order order)
+{
+    std::atomic_thread_fence(to_backend(order));
+}
+#else
+typedef memory_order backend_memory_order;
+
+inline memory_order to_backend(memory_order order)
+{
+    return order;
+}
+
+inline void atomic_thread_fence(memory_order order)
+{
+    boost::atomic_thread_fence(order);
+}
+#endif
+
+#ifdef BOOST_LOCKFREE_DCAS_BUILTIN
+
+/** 16 byte atomic, implemented with cmpxchg16b
+ *
+ *  Boost.Atomic and std::atomic may fall back to a lock-based implementation or to out-of-line library calls for
+ *  16 byte types (tagged_ptr in dcas mode, tagged_ptr_pair). the __sync builtins are inlined as lock cmpxchg16b,
+ *  which is a full barrier, so the memory_order arguments are ignored.
+ *
+ *  \note load is implemented with cmpxchg16b as well, so the object must not be placed in read-only memory
+ * */
+template <typename T>
+class atomic_dcas
+{
+    __extension__ typedef unsigned __int128 word;
+
+    BOOST_STATIC_ASSERT(sizeof(T) == sizeof(word));
+
+    static word to_word(T const & value)
+    {
+        word ret;
+        std::memcpy(&ret, &value, sizeof(word));
+        return ret;
+    }
+
+    /* T is trivially copyable, but its default constructor may not be trivial. the copy goes through void*, as
+     * -Wclass-memaccess would warn about a memcpy into such a type */
+    static T from_word(word w)
+    {
+        T ret;
+        std::memcpy(static_cast<void*>(&ret), &w, sizeof(word));
+        return ret;
+    }
+
+    atomic_dcas(atomic_dcas const &);
+    atomic_dcas & operator=(atomic_dcas const &);
+
+    word cas(word expected, word desired) const volatile
+    {
+        return __sync_val_compare_and_swap(&storage_, expected, desired);
+    }
+
+public:
+    atomic_dcas(void):
+        storage_(0)
+    {}
+
+    explicit atomic_dcas(T const & value):
+        storage_(to_word(value))
+    {}
+
+    T load(backend_memory_order = backend_memory_order()) const volatile
+    {
+        return from_word(cas(0, 0));
+    }
+
+    void store(T const & value, backend_memory_order order = backend_memory_order()) volatile
+    {
+        exchange(value, order);
+    }
+
+    T exchange(T const & value, backend_memory_order = backend_memory_order()) volatile
+    {
+        word desired = to_word(value);
+        word old = storage_; /* may be torn, the cas validates it */
+        for (;;) {
+            word prev = cas(old, desired);
+            if (prev == old)
+                return from_word(prev);
+            old = prev;
+        }
+    }
+
+    bool compare_exchange_strong(T & expected, T const & desired,
+                                 backend_memory_order, backend_memory_order) volatile
+    {
+        word old = to_word(expected);
+        word prev = cas(old, to_word(desired));
+        if (prev == old)
+            return true;
+
+        expected = from_word(prev);
+        return false;
+    }
+
+    bool compare_exchange_strong(T & expected, T const & desired, backend_memory_order = backend_memory_order()) volatile
+    {
+        return compare_exchange_strong(expected, desired, backend_memory_order(), backend_memory_order());
+    }
+
+    bool compare_exchange_weak(T & expected, T const & desired,
+                               backend_memory_order, backend_memory_order) volatile
+    {
+        return compare_exchange_strong(expected, desired);
+    }
+
+    bool compare_exchange_weak(T & expected, T const & desired, backend_memory_order = backend_memory_order()) volatile
+    {
+        return compare_exchange_strong(expected, desired);
+    }
+
+    bool is_lock_free(void) const volatile
+    {
+        return true;
+    }
+
+private:
+    mutable volatile word storage_;
+};
+
+template <typename T>
+struct use_dcas
+{
+    static const bool value = sizeof(T) == 16;
+};
+
+#else
+
+template <typename T>
+struct use_dcas
+{
+    static const bool value = false;
+};
+
+#endif /* BOOST_LOCKFREE_DCAS_BUILTIN */
+
+template <typename T>
+struct atomic_backend
+{
+#ifdef BOOST_LOCKFREE_DCAS_BUILTIN
+    typedef typename mpl::if_c<use_dcas<T>::value,
+                               atomic_dcas<T>,
+#ifdef BOOST_LOCKFREE_STD_ATOMIC
+                               std::atomic<T>
+#else
+                               boost::atomic<T>
+#endif
+                              >::type type;
+#elif defined(BOOST_LOCKFREE_STD_ATOMIC)
+    typedef std::atomic<T> type;
+#else
+    typedef boost::atomic<T> type;
+#endif
+};
+
+/** atomic object, which is used by all containers
+ *
+ *  forwards to std::atomic, Boost.Atomic or atomic_dcas and takes the memory_order constants of Boost.Atomic.
+ *
+ *  configurations, in which the atomic would be emulated with locks, are rejected at compile time, unless
+ *  BOOST_LOCKFREE_ALLOW_BLOCKING_ATOMICS is defined. on x86_64 this usually means that the code needs to be compiled
+ *  with -mcx16.
+ *
+ *  like Boost.Atomic, all member functions are volatile-qualified, so they can be used from volatile member functions.
+ * */
+template <typename T>
+class atomic
+{
+    typedef typename atomic_backend<T>::type backend;
+
+    /* not derived from boost::noncopyable: most containers are noncopyable themselves, and an atomic member with the
+     * same empty base would prevent the empty base optimization */
+    atomic(atomic const &);
+    atomic & operator=(atomic const &);
+
+#if defined(__GCC_ATOMIC_INT_LOCK_FREE) && !defined(BOOST_LOCKFREE_ALLOW_BLOCKING_ATOMICS)
+    BOOST_STATIC_ASSERT(use_dcas<T>::value || __atomic_always_lock_free(sizeof(T), 0));
+#endif
+
+public:
+    /* value-initialize the backend: the default constructor of std::atomic leaves its value uninitialized */
+    atomic(void):
+        impl_()
+    {}
+
+    explicit atomic(T const & value):
+        impl_(value)
+    {}
+
+    T load(memory_order order = memory_order_seq_cst) const volatile
+    {
+        return impl_.load(to_backend(order));
+    }
+
+    void store(T const & value, memory_order order = memory_order_seq_cst) volatile
+    {
+        impl_.store(value, to_backend(order));
+    }
+
+    T exchange(T const & value, memory_order order = memory_order_seq_cst) volatile
+    {
+        return impl_.exchange(value, to_backend(order));
+    }
+
+    bool compare_exchange_strong(T & expected, T const & desired, memory_order success, memory_order failure) volatile
+    {
+        return impl_.compare_exchange_strong(expected, desired, to_backend(success), to_backend(failure));
+    }
+
+    bool compare_exchange_strong(T & expected, T const & desired, memory_order order = memory_order_seq_cst) volatile
+    {
+        return impl_.compare_exchange_strong(expected, desired, to_backend(order));
+    }
+
+    bool compare_exchange_weak(T & expected, T const & desired, memory_order success, memory_order failure) volatile
+    {
+        return impl_.compare_exchange_weak(expected, desired, to_backend(success), to_backend(failure));
+    }
+
+    bool compare_exchange_weak(T & expected, T const & desired, memory_order order = memory_order_seq_cst) volatile
+    {
+        return impl_.compare_exchange_weak(expected, desired, to_backend(order));
+    }
+
+    /** integral operations, only available for integral types */
+    /* @{ */
+    T fetch_add(T value, memory_order order = memory_order_seq_cst) volatile
+    {
+        return impl_.fetch_add(value, to_backend(order));
+    }
+
+    T fetch_sub(T value, memory_order order = memory_order_seq_cst) volatile
+    {
+        return impl_.fetch_sub(value, to_backend(order));
+    }
+
+    T fetch_and(T value, memory_order order = memory_order_seq_cst) volatile
+    {
+        return impl_.fetch_and(value, to_backend(order));
+    }
+
+    T fetch_or(T value, memory_order order = memory_order_seq_cst) volatile
+    {
+        return impl_.fetch_or(value, to_backend(order));
+    }
+
+    T operator++(void) volatile
+    {
+        return fetch_add(1) + 1;
+    }
+
+    T operator++(int) volatile
+    {
+        return fetch_add(1);
+    }
+
+    T operator--(void) volatile
+    {
+        return fetch_sub(1) - 1;
+    }
+
+    T operator--(int) volatile
+    {
+        return fetch_sub(1);
+    }
+    /* @} */
+
+    operator T(void) const volatile
+    {
+        return load();
+    }
+
+    T operator=(T const & value) volatile
+    {
+        store(value);
+        return value;
+    }
+
+    //! \return true, if the atomic is implemented without locks
+    bool is_lock_free(void) const volatile
+    {
+        return impl_.is_lock_free();
+    }
+
+private:
+    backend impl_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_DETAIL_ATOMIC_HPP_INCLUDED */
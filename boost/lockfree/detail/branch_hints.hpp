@@ -34,6 +34,17 @@ namespace lockfree
 #endif
     }
 
+namespace detail
+{
+    /** \brief hint for the cpu, that the calling thread is spinning */
+    inline void spin_pause(void)
+    {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+        __builtin_ia32_pause();
+#endif
+    }
+} /* namespace detail */
+
 } /* namespace lockfree */
 } /* namespace boost */
 
@@ -0,0 +1,240 @@
+//  bulk copy helpers for ringbuffer transfers
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_BULK_COPY_HPP_INCLUDED
+#define BOOST_LOCKFREE_BULK_COPY_HPP_INCLUDED
+
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_pod.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+/* this file defines the following macros:
+   BOOST_LOCKFREE_STREAMING_COPY_THRESHOLD: minimum size of a bulk transfer in bytes, for which the producer copies
+                                            with non-temporal stores, bypassing its own cache
+   BOOST_LOCKFREE_HAVE_STREAMING_COPY:      defined, if non-temporal copies are implemented for the target
+
+   it honors the following macros:
+   BOOST_LOCKFREE_STREAMING_COPY_STATISTICS: count the sections, which are copied with non-temporal stores (for tests)
+*/
+
+#ifndef BOOST_LOCKFREE_STREAMING_COPY_THRESHOLD
+#define BOOST_LOCKFREE_STREAMING_COPY_THRESHOLD 16384
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define BOOST_LOCKFREE_HAVE_STREAMING_COPY
+#include <immintrin.h>
+#endif
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+#ifdef BOOST_LOCKFREE_HAVE_STREAMING_COPY
+
+enum streaming_copy_isa
+{
+    isa_none,
+    isa_sse2,
+    isa_avx
+};
+
+inline streaming_copy_isa detect_streaming_copy_isa(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx"))
+        return isa_avx;
+    if (__builtin_cpu_supports("sse2"))
+        return isa_sse2;
+    return isa_none;
+}
+
+inline streaming_copy_isa streaming_copy_support(void)
+{
+    static const streaming_copy_isa isa = detect_streaming_copy_isa();
+    return isa;
+}
+
+__attribute__((target("sse2")))
+inline void streaming_copy_sse2(char * out, const char * in, std::size_t bytes)
+{
+    std::size_t head = std::min((16 - (reinterpret_cast<std::size_t>(out) & 15)) & 15, bytes);
+    std::memcpy(out, in, head);
+    out += head;
+    in += head;
+    bytes -= head;
+
+    for (; bytes >= 64; bytes -= 64, in += 64, out += 64) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 32));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(out),      a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(out + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(out + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(out + 48), d);
+    }
+    std::memcpy(out, in, bytes);
+
+    /* non-temporal stores are weakly ordered, they must be visible before the index is published */
+    _mm_sfence();
+}
+
+__attribute__((target("avx")))
+inline void streaming_copy_avx(char * out, const char * in, std::size_t bytes)
+{
+    std::size_t head = std::min((32 - (reinterpret_cast<std::size_t>(out) & 31)) & 31, bytes);
+    std::memcpy(out, in, head);
+    out += head;
+    in += head;
+    bytes -= head;
+
+    for (; bytes >= 128; bytes -= 128, in += 128, out += 128) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 64));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(out),      a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(out + 32), b);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(out + 64), c);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(out + 96), d);
+    }
+    std::memcpy(out, in, bytes);
+
+    _mm_sfence();
+    _mm256_zeroupper();
+}
+
+#ifdef BOOST_LOCKFREE_STREAMING_COPY_STATISTICS
+/* not synchronized, only meant for single-threaded tests */
+inline std::size_t & streaming_copy_sections(void)
+{
+    static std::size_t sections = 0;
+    return sections;
+}
+#endif
+
+/* returns false, if the cpu does not support non-temporal stores */
+inline bool streaming_copy(void * out, const void * in, std::size_t bytes)
+{
+#ifdef BOOST_LOCKFREE_STREAMING_COPY_STATISTICS
+    if (streaming_copy_support() != isa_none)
+        ++streaming_copy_sections();
+#endif
+
+    switch (streaming_copy_support()) {
+    case isa_avx:
+        streaming_copy_avx(static_cast<char*>(out), static_cast<const char*>(in), bytes);
+        return true;
+
+    case isa_sse2:
+        streaming_copy_sse2(static_cast<char*>(out), static_cast<const char*>(in), bytes);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+#endif /* BOOST_LOCKFREE_HAVE_STREAMING_COPY */
+
+/* copy for the consumer side, prefetching the source ahead of the copied block */
+inline void prefetching_copy(void * out, const void * in, std::size_t bytes)
+{
+    static const std::size_t block_size = 1024;
+    static const std::size_t prefetch_distance = 2 * block_size;
+
+    char * o = static_cast<char*>(out);
+    const char * i = static_cast<const char*>(in);
+
+    for (; bytes > block_size; bytes -= block_size, i += block_size, o += block_size) {
+#ifdef __GNUC__
+        if (bytes > prefetch_distance)
+            for (std::size_t line = 0; line < block_size; line += 64)
+                __builtin_prefetch(i + prefetch_distance + line, 0, 0);
+#endif
+        std::memcpy(o, i, block_size);
+    }
+    std::memcpy(o, i, bytes);
+}
+
+template <typename T>
+void copy_to_buffer(T const * first, T const * last, T * out, bool, boost::false_type)
+{
+    std::copy(first, last, out);
+}
+
+template <typename T>
+void copy_to_buffer(T const * first, T const * last, T * out, bool large_transfer, boost::true_type)
+{
+    const std::size_t bytes = (last - first) * sizeof(T);
+#ifdef BOOST_LOCKFREE_HAVE_STREAMING_COPY
+    if (large_transfer && streaming_copy(out, first, bytes))
+        return;
+#endif
+    std::memcpy(out, first, bytes);
+}
+
+template <typename T>
+void copy_from_buffer(T const * first, T const * last, T * out, bool, boost::false_type)
+{
+    std::copy(first, last, out);
+}
+
+template <typename T>
+void copy_from_buffer(T const * first, T const * last, T * out, bool large_transfer, boost::true_type)
+{
+    const std::size_t bytes = (last - first) * sizeof(T);
+    if (large_transfer)
+        prefetching_copy(out, first, bytes);
+    else
+        std::memcpy(out, first, bytes);
+}
+
+/** \return true, if a transfer of count elements reaches BOOST_LOCKFREE_STREAMING_COPY_THRESHOLD
+ *
+ *  the decision is made for the whole transfer, so both sections of a transfer, which wraps around the end of the
+ *  buffer, are copied the same way.
+ * */
+template <typename T>
+bool is_large_transfer(std::size_t count)
+{
+    return count * sizeof(T) >= BOOST_LOCKFREE_STREAMING_COPY_THRESHOLD;
+}
+
+/** Copies elements into a ringbuffer. For large transfers of PODs, non-temporal stores are used, so that the data,
+ *  which is only read by the consumer, does not pollute the cache of the producer.
+ * */
+template <typename T>
+void copy_to_buffer(T const * first, T const * last, T * out, bool large_transfer)
+{
+    copy_to_buffer(first, last, out, large_transfer, boost::integral_constant<bool, boost::is_pod<T>::value>());
+}
+
+/** Copies elements out of a ringbuffer. For large transfers of PODs, the source is prefetched. */
+template <typename T>
+void copy_from_buffer(T const * first, T const * last, T * out, bool large_transfer)
+{
+    copy_from_buffer(first, last, out, large_transfer, boost::integral_constant<bool, boost::is_pod<T>::value>());
+}
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_BULK_COPY_HPP_INCLUDED */
@@ -0,0 +1,126 @@
+//  eventcount: lets threads sleep until a lock-free data structure changes its state
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_EVENTCOUNT_HPP_INCLUDED
+#define BOOST_LOCKFREE_EVENTCOUNT_HPP_INCLUDED
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <climits>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#endif
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+/** The eventcount implements the waiting side of blocking operations on top of non-blocking operations:
+ *
+ *  \code
+ *  for (;;) {
+ *      key = ec.prepare_wait();
+ *      if (try_operation()) {
+ *          ec.cancel_wait();
+ *          break;
+ *      }
+ *      ec.commit_wait(key, timeout);
+ *  }
+ *  \endcode
+ *
+ *  The thread changing the state of the data structure calls notify() afterwards. notify() issues a system call
+ *  only if a thread is waiting, the common case costs a full fence and a load.
+ *
+ *  On linux, waiting threads sleep on a futex. On other platforms, waiting threads poll with a short sleep.
+ * */
+class eventcount:
+    boost::noncopyable
+{
+    atomic<boost::uint32_t> epoch_;
+    atomic<boost::uint32_t> waiters_;
+
+    BOOST_STATIC_ASSERT(sizeof(atomic<boost::uint32_t>) == sizeof(int));
+
+public:
+    eventcount(void):
+        epoch_(0), waiters_(0)
+    {}
+
+    /** Announce a waiter.
+     *
+     * \return key for commit_wait
+     * */
+    boost::uint32_t prepare_wait(void)
+    {
+        waiters_.fetch_add(1, memory_order_relaxed);
+        /* pairs with the fence in notify: either the notifier sees the waiter, or we see its state change */
+        detail::atomic_thread_fence(memory_order_seq_cst);
+        return epoch_.load(memory_order_acquire);
+    }
+
+    //! Withdraw the announcement of prepare_wait, without sleeping
+    void cancel_wait(void)
+    {
+        waiters_.fetch_sub(1, memory_order_relaxed);
+    }
+
+    /** Sleep until notify() is called after prepare_wait returned key, or the timeout expires. Spurious wakeups are
+     *  possible.
+     * */
+    void commit_wait(boost::uint32_t key, boost::posix_time::time_duration const & timeout)
+    {
+#ifdef __linux__
+        const boost::int64_t ns = timeout.total_nanoseconds();
+        struct timespec ts;
+        ts.tv_sec = ns / 1000000000;
+        ts.tv_nsec = ns % 1000000000;
+        ::syscall(SYS_futex, reinterpret_cast<int*>(&epoch_), FUTEX_WAIT_PRIVATE, int(key), &ts, NULL, 0);
+#else
+        if (epoch_.load(memory_order_acquire) == key)
+            boost::this_thread::sleep(std::min(timeout, boost::posix_time::time_duration(boost::posix_time::microseconds(100))));
+#endif
+        waiters_.fetch_sub(1, memory_order_relaxed);
+    }
+
+    //! Wake all waiting threads. Has to be called after the state change, which the waiters are waiting for.
+    void notify(void)
+    {
+        detail::atomic_thread_fence(memory_order_seq_cst);
+        if (likely(waiters_.load(memory_order_relaxed) == 0))
+            return;
+
+        epoch_.fetch_add(1, memory_order_release);
+#ifdef __linux__
+        ::syscall(SYS_futex, reinterpret_cast<int*>(&epoch_), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#endif
+    }
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_EVENTCOUNT_HPP_INCLUDED */
@@ -11,17 +11,23 @@
 #ifndef BOOST_LOCKFREE_FREELIST_HPP_INCLUDED
 #define BOOST_LOCKFREE_FREELIST_HPP_INCLUDED
 
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/tagged_index.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
+#include <boost/lockfree/policies.hpp>
 
-#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
 
-#include <boost/mpl/map.hpp>
-#include <boost/mpl/apply.hpp>
-#include <boost/mpl/at.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
 #include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <cstring>
+#include <memory>
 #include <algorithm>            /* for std::min */
 
 namespace boost
@@ -53,7 +59,7 @@ public:
         {
             T * node = Alloc::allocate(1);   // initialize once
             std::memset(node, '\0', sizeof(T));
-            deallocate(node);
+            unsynchronized_deallocate(node);
         }
     }
 
@@ -62,12 +68,15 @@ public:
         free_memory_pool();
     }
 
+    /* memory ordering: deallocate publishes the node with a release cas, after the previous owner has finished
+     * using it. allocate dereferences the head of the pool after the initial load and after a failed cas, so both
+     * are acquire, which also makes the writes of the previous owner visible to the new owner */
     T * allocate (void)
     {
+        tagged_ptr old_pool = pool_.load(memory_order_acquire);
+
         for(;;)
         {
-            tagged_ptr old_pool = pool_.load(memory_order_consume);
-
             if (!old_pool.get_ptr()) {
                 T* node = Alloc::allocate(1);   // initialize once
                 std::memset(node, '\0', sizeof(T));
@@ -77,7 +86,7 @@ public:
             freelist_node * new_pool_ptr = old_pool->next.get_ptr();
             tagged_ptr new_pool (new_pool_ptr, old_pool.get_tag() + 1);
 
-            if (pool_.compare_exchange_strong(old_pool, new_pool)) {
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_acquire, memory_order_acquire)) {
                 void * ptr = old_pool.get_ptr();
                 return reinterpret_cast<T*>(ptr);
             }
@@ -86,17 +95,17 @@ public:
 
     T* get(void)
     {
+        tagged_ptr old_pool = pool_.load(memory_order_acquire);
+
         for(;;)
         {
-            tagged_ptr old_pool = pool_.load(memory_order_consume);
-
             if (!old_pool.get_ptr()) 
                 return NULL;
 
             freelist_node * new_pool_ptr = old_pool->next.get_ptr();
             tagged_ptr new_pool (new_pool_ptr, old_pool.get_tag() + 1);
 
-            if (pool_.compare_exchange_strong(old_pool, new_pool)) {
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_acquire, memory_order_acquire)) {
                 void * ptr = old_pool.get_ptr();
                 return reinterpret_cast<T*>(ptr);
             }
@@ -106,20 +115,55 @@ public:
     void deallocate (T * n)
     {
         void * node = n;
+        tagged_ptr old_pool = pool_.load(memory_order_relaxed);
+
         for(;;)
         {
-            tagged_ptr old_pool = pool_.load(memory_order_consume);
-
             freelist_node * new_pool_ptr = reinterpret_cast<freelist_node*>(node);
             tagged_ptr new_pool (new_pool_ptr, old_pool.get_tag() + 1);
 
             new_pool->next.set_ptr(old_pool.get_ptr());
 
-            if (pool_.compare_exchange_strong(old_pool, new_pool))
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_release, memory_order_relaxed))
                 return;
         }
     }
 
+    /** \name unsynchronized allocation
+     *
+     *  plain loads and stores instead of compare-and-swap loops. the caller guarantees, that no other thread accesses
+     *  the freelist, and synchronizes with the threads, which access it later, e.g. by starting them afterwards.
+     * */
+    /* @{ */
+    T * unsynchronized_allocate (void)
+    {
+        tagged_ptr old_pool = pool_.load(memory_order_relaxed);
+
+        if (!old_pool.get_ptr()) {
+            T* node = Alloc::allocate(1);   // initialize once
+            std::memset(static_cast<void*>(node), '\0', sizeof(T)); /* T may not be trivially assignable */
+            return node;
+        }
+
+        freelist_node * new_pool_ptr = old_pool->next.get_ptr();
+        pool_.store(tagged_ptr(new_pool_ptr, old_pool.get_tag() + 1), memory_order_relaxed);
+
+        void * ptr = old_pool.get_ptr();
+        return reinterpret_cast<T*>(ptr);
+    }
+
+    void unsynchronized_deallocate (T * n)
+    {
+        void * node = n;
+        tagged_ptr old_pool = pool_.load(memory_order_relaxed);
+
+        freelist_node * new_pool_ptr = reinterpret_cast<freelist_node*>(node);
+        new_pool_ptr->next.set_ptr(old_pool.get_ptr());
+
+        pool_.store(tagged_ptr(new_pool_ptr, old_pool.get_tag() + 1), memory_order_relaxed);
+    }
+    /* @} */
+
 private:
     void free_memory_pool(void)
     {
@@ -133,7 +177,7 @@ private:
         }
     }
 
-    atomic<tagged_ptr> pool_;
+    detail::atomic<tagged_ptr> pool_;
 };
 
 template <typename T, typename Alloc = std::allocator<T> >
@@ -157,7 +201,7 @@ public:
         for (std::size_t i = 0; i != max_nodes; ++i)
         {
             T* node = chunks + i;   // initialize once
-            deallocate(node);
+            unsynchronized_deallocate(node);
         }
     }
 
@@ -166,19 +210,20 @@ public:
         Alloc::deallocate(chunks, total_nodes);
     }
 
+    /* memory ordering: see caching_freelist */
     T * allocate (void)
     {
+        tagged_ptr old_pool = pool_.load(memory_order_acquire);
+
         for(;;)
         {
-            tagged_ptr old_pool = pool_.load(memory_order_consume);
-
             if (!old_pool.get_ptr())
                 return NULL; /* allocation fails */
 
             freelist_node * new_pool_ptr = old_pool->next.get_ptr();
             tagged_ptr new_pool (new_pool_ptr, old_pool.get_tag() + 1);
 
-            if (pool_.compare_exchange_strong(old_pool, new_pool)) {
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_acquire, memory_order_acquire)) {
                 void * ptr = old_pool.get_ptr();
                 return reinterpret_cast<T*>(ptr);
             }
@@ -188,53 +233,430 @@ public:
     void deallocate (T * n)
     {
         void * node = n;
+        tagged_ptr old_pool = pool_.load(memory_order_relaxed);
+
         for(;;)
         {
-            tagged_ptr old_pool = pool_.load(memory_order_consume);
-
             freelist_node * new_pool_ptr = reinterpret_cast<freelist_node*>(node);
             tagged_ptr new_pool (new_pool_ptr, old_pool.get_tag());
 
             new_pool->next.set_ptr(old_pool.get_ptr());
 
-            if (pool_.compare_exchange_strong(old_pool, new_pool))
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_release, memory_order_relaxed))
+                return;
+        }
+    }
+
+    //! \copydoc caching_freelist::unsynchronized_allocate
+    T * unsynchronized_allocate (void)
+    {
+        tagged_ptr old_pool = pool_.load(memory_order_relaxed);
+
+        if (!old_pool.get_ptr())
+            return NULL; /* allocation fails */
+
+        freelist_node * new_pool_ptr = old_pool->next.get_ptr();
+        pool_.store(tagged_ptr(new_pool_ptr, old_pool.get_tag() + 1), memory_order_relaxed);
+
+        void * ptr = old_pool.get_ptr();
+        return reinterpret_cast<T*>(ptr);
+    }
+
+    void unsynchronized_deallocate (T * n)
+    {
+        void * node = n;
+        tagged_ptr old_pool = pool_.load(memory_order_relaxed);
+
+        freelist_node * new_pool_ptr = reinterpret_cast<freelist_node*>(node);
+        new_pool_ptr->next.set_ptr(old_pool.get_ptr());
+
+        pool_.store(tagged_ptr(new_pool_ptr, old_pool.get_tag()), memory_order_relaxed);
+    }
+
+private:
+    detail::atomic<tagged_ptr> pool_;
+
+    const std::size_t total_nodes;
+    T* chunks;
+};
+
+
+/** The indexed_freelist class provides a fixed-sized freelist, whose nodes can be addressed by 32bit indices instead
+ *  of pointers. Index 0 denotes the null pointer. Containers can use the indices to pack several node references
+ *  into a single word, which can be updated with a single-width compare-and-swap.
+ *
+ * */
+template <typename T, typename Alloc = std::allocator<T> >
+class indexed_freelist:
+    private boost::noncopyable,
+    private Alloc
+{
+    struct freelist_node
+    {
+        boost::uint32_t next;
+    };
+
+    /* index of the first free node in the lower, aba tag in the upper 32 bits */
+    typedef boost::uint64_t tagged_index;
+
+    static boost::uint32_t extract_index(tagged_index t)
+    {
+        return boost::uint32_t(t);
+    }
+
+    static boost::uint32_t extract_tag(tagged_index t)
+    {
+        return boost::uint32_t(t >> 32);
+    }
+
+    static tagged_index make_tagged_index(boost::uint32_t index, boost::uint32_t tag)
+    {
+        return (tagged_index(tag) << 32) | index;
+    }
+
+public:
+    typedef boost::uint32_t index_t;
+
+    explicit indexed_freelist(std::size_t max_nodes):
+        pool_(0), total_nodes(max_nodes)
+    {
+        BOOST_STATIC_ASSERT(sizeof(T) >= sizeof(freelist_node));
+
+        chunks = Alloc::allocate(max_nodes);
+        std::memset(static_cast<void*>(chunks), '\0', max_nodes*sizeof(T)); /* T may not be trivially assignable */
+
+        /* push in reverse order, so that the nodes are allocated in address order */
+        for (std::size_t i = max_nodes; i != 0; --i)
+            unsynchronized_deallocate(chunks + i - 1);
+    }
+
+    ~indexed_freelist(void)
+    {
+        Alloc::deallocate(chunks, total_nodes);
+    }
+
+    /* memory ordering: see caching_freelist */
+    T * allocate (void)
+    {
+        tagged_index old_pool = pool_.load(memory_order_acquire);
+
+        for(;;)
+        {
+            T * node = pointer(extract_index(old_pool));
+            if (!node)
+                return NULL; /* allocation fails */
+
+            boost::uint32_t next = reinterpret_cast<freelist_node*>(node)->next;
+            tagged_index new_pool = make_tagged_index(next, extract_tag(old_pool) + 1);
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_acquire, memory_order_acquire))
+                return node;
+        }
+    }
+
+    void deallocate (T * n)
+    {
+        index_t index = get_index(n);
+        tagged_index old_pool = pool_.load(memory_order_relaxed);
+
+        for(;;)
+        {
+            reinterpret_cast<freelist_node*>(n)->next = extract_index(old_pool);
+            tagged_index new_pool = make_tagged_index(index, extract_tag(old_pool));
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_release, memory_order_relaxed))
                 return;
         }
     }
 
+    //! \copydoc caching_freelist::unsynchronized_allocate
+    T * unsynchronized_allocate (void)
+    {
+        tagged_index old_pool = pool_.load(memory_order_relaxed);
+
+        T * node = pointer(extract_index(old_pool));
+        if (!node)
+            return NULL; /* allocation fails */
+
+        boost::uint32_t next = reinterpret_cast<freelist_node*>(node)->next;
+        pool_.store(make_tagged_index(next, extract_tag(old_pool) + 1), memory_order_relaxed);
+        return node;
+    }
+
+    void unsynchronized_deallocate (T * n)
+    {
+        tagged_index old_pool = pool_.load(memory_order_relaxed);
+
+        reinterpret_cast<freelist_node*>(n)->next = extract_index(old_pool);
+        pool_.store(make_tagged_index(get_index(n), extract_tag(old_pool)), memory_order_relaxed);
+    }
+
+    //! \returns index of node n, 0 if n is NULL
+    index_t get_index(T const * n) const
+    {
+        return n ? index_t(n - chunks + 1) : 0;
+    }
+
+    //! \returns node with the index i, NULL if i is 0
+    T * pointer(index_t i) const
+    {
+        return i ? chunks + i - 1 : NULL;
+    }
+
+    //! \returns number of nodes of the freelist
+    std::size_t capacity(void) const
+    {
+        return total_nodes;
+    }
+
 private:
-    atomic<tagged_ptr> pool_;
+    detail::atomic<tagged_index> pool_;
 
     const std::size_t total_nodes;
     T* chunks;
 };
 
+/** The fixed_freelist class provides a freelist of max_nodes nodes, which are stored inside the freelist object
+ *  instead of being allocated from the heap. Like the indexed_freelist, its nodes are addressed by indices, index 0
+ *  denotes the null pointer. The index type is the smallest type, which can address all nodes, so containers can pack
+ *  an index and an aba tag into a 32bit word, if there are less than 65535 nodes.
+ *
+ * */
+template <typename T, std::size_t max_nodes>
+class fixed_freelist:
+    private boost::noncopyable
+{
+public:
+    typedef typename detail::select_tagged_index<max_nodes>::type tagged_index_t;
+    typedef typename tagged_index_t::index_t index_t;
+
+private:
+    struct freelist_node
+    {
+        index_t next;
+    };
+
+    BOOST_STATIC_ASSERT(sizeof(T) >= sizeof(freelist_node));
+
+    detail::atomic<tagged_index_t> pool_;
+    typename boost::aligned_storage<sizeof(T) * max_nodes, boost::alignment_of<T>::value>::type storage_;
+
+    T * nodes(void) const
+    {
+        return static_cast<T*>(const_cast<void*>(storage_.address()));
+    }
+
+public:
+    fixed_freelist(void):
+        pool_(tagged_index_t(0, 0))
+    {
+        /* push in reverse order, so that the nodes are allocated in address order */
+        for (std::size_t i = max_nodes; i != 0; --i)
+            unsynchronized_deallocate(nodes() + i - 1);
+    }
+
+    /* memory ordering: see caching_freelist */
+    T * allocate (void)
+    {
+        tagged_index_t old_pool = pool_.load(memory_order_acquire);
+
+        for(;;)
+        {
+            T * node = pointer(old_pool.get_index());
+            if (!node)
+                return NULL; /* allocation fails */
+
+            index_t next = reinterpret_cast<freelist_node*>(node)->next;
+            tagged_index_t new_pool(next, old_pool.get_tag() + 1);
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_acquire, memory_order_acquire))
+                return node;
+        }
+    }
+
+    void deallocate (T * n)
+    {
+        index_t index = get_index(n);
+        tagged_index_t old_pool = pool_.load(memory_order_relaxed);
+
+        for(;;)
+        {
+            reinterpret_cast<freelist_node*>(n)->next = old_pool.get_index();
+            tagged_index_t new_pool(index, old_pool.get_tag());
+
+            if (pool_.compare_exchange_weak(old_pool, new_pool, memory_order_release, memory_order_relaxed))
+                return;
+        }
+    }
+
+    //! \copydoc caching_freelist::unsynchronized_allocate
+    T * unsynchronized_allocate (void)
+    {
+        tagged_index_t old_pool = pool_.load(memory_order_relaxed);
+
+        T * node = pointer(old_pool.get_index());
+        if (!node)
+            return NULL; /* allocation fails */
+
+        index_t next = reinterpret_cast<freelist_node*>(node)->next;
+        pool_.store(tagged_index_t(next, old_pool.get_tag() + 1), memory_order_relaxed);
+        return node;
+    }
+
+    void unsynchronized_deallocate (T * n)
+    {
+        tagged_index_t old_pool = pool_.load(memory_order_relaxed);
+
+        reinterpret_cast<freelist_node*>(n)->next = old_pool.get_index();
+        pool_.store(tagged_index_t(get_index(n), old_pool.get_tag()), memory_order_relaxed);
+    }
+
+    //! \returns index of node n, 0 if n is NULL
+    index_t get_index(T const * n) const
+    {
+        return n ? index_t(n - nodes() + 1) : 0;
+    }
+
+    //! \returns node with the index i, NULL if i is 0
+    T * pointer(index_t i) const
+    {
+        return i ? nodes() + i - 1 : NULL;
+    }
+
+    //! \returns number of nodes of the freelist
+    static std::size_t capacity(void)
+    {
+        return max_nodes;
+    }
+};
+
+/** The node_pool class provides a lock-free pool of memory blocks of node_size bytes, which can be shared by any
+ *  number of containers with the shared_freelist_t freelist policy, whose nodes fit into these blocks. Like the
+ *  caching_freelist, it allocates blocks from the operating system on demand and only frees them in its destructor.
+ *
+ *  The pool has to outlive all containers, which use it.
+ *
+ * */
+template <std::size_t node_size, std::size_t alignment = sizeof(void*)>
+class node_pool:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename boost::aligned_storage<node_size, alignment>::type block;
 
-struct caching_freelist_t {};
-struct static_freelist_t {};
+    caching_freelist<block> pool_;
+#endif
+
+public:
+    //! size and alignment of the blocks
+    static const std::size_t block_size = node_size;
+    static const std::size_t block_alignment = alignment;
+
+    //! Constructs a pool with a number of initially allocated blocks.
+    explicit node_pool(std::size_t initial_nodes = 0):
+        pool_(initial_nodes)
+    {}
+
+    /** \returns pointer to a block of node_size bytes
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if a block needs to be allocated from the operating system
+     * */
+    void * allocate(void)
+    {
+        return pool_.allocate();
+    }
+
+    /** Returns a block to the pool.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    void deallocate(void * n)
+    {
+        pool_.deallocate(static_cast<block*>(n));
+    }
+};
 
 namespace detail
 {
 
-#if 0
-template <typename T, typename Alloc, typename tag>
+/* adapts a shared node_pool to the freelist interface of the containers */
+template <typename T, typename Pool>
+class freelist_ref
+{
+    BOOST_STATIC_ASSERT(sizeof(T) <= Pool::block_size);
+    BOOST_STATIC_ASSERT(boost::alignment_of<T>::value <= Pool::block_alignment);
+
+    Pool & pool_;
+
+public:
+    explicit freelist_ref(Pool & pool):
+        pool_(pool)
+    {}
+
+    T * allocate (void)
+    {
+        return static_cast<T*>(pool_.allocate());
+    }
+
+    void deallocate (T * n)
+    {
+        pool_.deallocate(n);
+    }
+
+    /* the pool is shared with other containers, so it is always accessed with synchronization */
+    T * unsynchronized_allocate (void)
+    {
+        return allocate();
+    }
+
+    void unsynchronized_deallocate (T * n)
+    {
+        deallocate(n);
+    }
+};
+
+/* node_pool for containers with value type T. a block holds two tagged pointers next to the value, which fits the
+ * largest node (deque) and the nodes of fifo and stack, so containers of different kinds can share one pool */
+template <typename T>
+struct shared_pool
+{
+private:
+    typedef detail::atomic<tagged_ptr<T> > link;
+
+    static const std::size_t alignment = boost::alignment_of<link>::value > boost::alignment_of<T>::value
+                                             ? boost::alignment_of<link>::value
+                                             : boost::alignment_of<T>::value;
+    static const std::size_t node_size = (2 * sizeof(link) + sizeof(T) + alignment - 1) / alignment * alignment;
+
+public:
+    typedef node_pool<node_size, alignment> type;
+};
+
+/* SharedPool is the pool_type of a container with value type T, which is used with the shared_freelist_t policy */
+template <typename T, typename Alloc, typename tag, typename SharedPool = node_pool<sizeof(T), boost::alignment_of<T>::value> >
 struct select_freelist
 {
 private:
     typedef typename Alloc::template rebind<T>::other Allocator;
 
-    typedef typename boost::lockfree::caching_freelist<T, Allocator> cfl;
-    typedef typename boost::lockfree::static_freelist<T, Allocator> sfl;
+    typedef boost::lockfree::caching_freelist<T, Allocator> cfl;
+    typedef boost::lockfree::static_freelist<T, Allocator> sfl;
+    typedef boost::lockfree::indexed_freelist<T, Allocator> ifl;
+    typedef freelist_ref<T, SharedPool> sharedfl;
 
-    typedef typename boost::mpl::map<
-        boost::mpl::pair < caching_freelist_t, cfl/* typename boost::lockfree::caching_freelist<T, Alloc> */ >,
-        boost::mpl::pair < static_freelist_t,  sfl/* typename boost::lockfree::static_freelist<T, Alloc> */ >,
-        int
-        > freelists;
 public:
-    typedef typename boost::mpl::at<freelists, tag>::type type;
+    typedef typename boost::mpl::if_<boost::is_same<tag, caching_freelist_t>,
+                                     cfl,
+                                     typename boost::mpl::if_<boost::is_same<tag, static_freelist_t>,
+                                                              sfl,
+                                                              typename boost::mpl::if_<boost::is_same<tag, indexed_freelist_t>,
+                                                                                       ifl,
+                                                                                       sharedfl
+                                                                                      >::type
+                                                             >::type
+                                    >::type type;
 };
-#endif
 
 } /* namespace detail */
 } /* namespace lockfree */
@@ -0,0 +1,137 @@
+//  virtual memory mirrored storage for ringbuffers
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_MIRRORED_STORAGE_HPP_INCLUDED
+#define BOOST_LOCKFREE_MIRRORED_STORAGE_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/type_traits/is_pod.hpp>
+
+#include <cerrno>
+#include <cstddef>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+/** Buffer of POD elements, which is mapped twice, back to back, in the virtual address space.
+ *
+ *  Element i and element i + size() share the same memory, so any window of up to size() elements
+ *  starting inside the buffer is contiguous, even if it wraps around the end of the buffer.
+ *
+ *  The size is rounded up, so that the buffer covers a multiple of the page size.
+ *
+ *  \note Linux only, the memory is obtained via memfd_create
+ * */
+template <typename T>
+class mirrored_storage:
+    boost::noncopyable
+{
+    BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+
+    static std::size_t gcd(std::size_t a, std::size_t b)
+    {
+        while (b) {
+            std::size_t r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    static void throw_last_error(const char * what)
+    {
+        throw boost::system::system_error(errno, boost::system::system_category(), what);
+    }
+
+public:
+    explicit mirrored_storage(std::size_t min_size)
+    {
+        const std::size_t page_size = ::sysconf(_SC_PAGESIZE);
+
+        /* smallest number of elements, which covers a whole number of pages */
+        const std::size_t unit = page_size / gcd(page_size, sizeof(T));
+        size_ = (min_size + unit - 1) / unit * unit;
+        if (size_ == 0)
+            size_ = unit;
+        bytes_ = size_ * sizeof(T);
+
+        int fd = ::syscall(__NR_memfd_create, "boost_lockfree_mirror", 0);
+        if (fd == -1)
+            throw_last_error("mirrored_storage: memfd_create");
+
+        if (::ftruncate(fd, bytes_) == -1) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throw_last_error("mirrored_storage: ftruncate");
+        }
+
+        /* reserve the address range for both mappings, then map the file twice into it */
+        void * reserved = ::mmap(NULL, 2 * bytes_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            throw_last_error("mirrored_storage: mmap");
+        }
+
+        char * base = static_cast<char*>(reserved);
+        if (::mmap(base, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+            ::mmap(base + bytes_, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+        {
+            int error = errno;
+            ::munmap(base, 2 * bytes_);
+            ::close(fd);
+            errno = error;
+            throw_last_error("mirrored_storage: mmap");
+        }
+
+        ::close(fd);
+        data_ = reinterpret_cast<T*>(base);
+    }
+
+    ~mirrored_storage(void)
+    {
+        ::munmap(data_, 2 * bytes_);
+    }
+
+    /** \return pointer to the first element. data()[i] and data()[i + size()] alias for i < size() */
+    T * data(void) const
+    {
+        return data_;
+    }
+
+    /** \return number of elements */
+    std::size_t size(void) const
+    {
+        return size_;
+    }
+
+private:
+    T * data_;
+    std::size_t size_;
+    std::size_t bytes_;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_MIRRORED_STORAGE_HPP_INCLUDED */
@@ -0,0 +1,64 @@
+//  cache-line padded sequence counters
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_SEQUENCE_HPP_INCLUDED
+#define BOOST_LOCKFREE_SEQUENCE_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+#include "prefix.hpp"
+
+#include <cstddef>
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+/** monotonically increasing sequence, owned by a single thread, together with the owner's cached copy of the
+ *  sequence it is gated on.
+ *
+ *  the padding in front of and behind the counters keeps the counters of adjacent sequences in an array on different
+ *  cache lines, independent of the alignment of the array.
+ * */
+struct padded_sequence:
+    boost::noncopyable
+{
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES];
+    atomic<std::size_t> value;
+    std::size_t cached; /* only accessed by the owner */
+    char padding2[BOOST_LOCKFREE_CACHELINE_BYTES - 2 * sizeof(std::size_t)];
+
+    padded_sequence(void):
+        value(0), cached(0)
+    {}
+};
+
+/* minimum of a set of sequences, at most initial */
+inline std::size_t minimum_sequence(padded_sequence const * sequences, std::size_t count, std::size_t initial)
+{
+    std::size_t ret = initial;
+    for (std::size_t i = 0; i != count; ++i) {
+        std::size_t value = sequences[i].value.load(memory_order_acquire);
+        if (value < ret)
+            ret = value;
+    }
+    return ret;
+}
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_SEQUENCE_HPP_INCLUDED */
@@ -0,0 +1,118 @@
+//  tagged index, for aba prevention in containers with inline storage
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_TAGGED_INDEX_HPP_INCLUDED
+#define BOOST_LOCKFREE_TAGGED_INDEX_HPP_INCLUDED
+
+#include <boost/cstdint.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/static_assert.hpp>
+
+#include <cstddef>
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+/** node index and aba tag, which fit into a single word.
+ *
+ *  by default, the tag is 32bit wide even for 16bit indices: a 16bit tag of the top of a container wraps around after
+ *  65536 operations, which a preempted thread can easily miss. like tagged_ptr, it is trivially copyable, so it can be
+ *  used with detail::atomic. index 0 denotes the null node.
+ * */
+template <typename Index, typename Tag = boost::uint32_t>
+class tagged_index
+{
+public:
+    typedef Index index_t;
+    typedef Tag tag_t;
+
+    BOOST_STATIC_ASSERT(sizeof(index_t) <= sizeof(tag_t));
+
+    tagged_index(void)
+    {}
+
+    tagged_index(index_t i, tag_t t):
+        index(i), tag(t)
+    {}
+
+    /** unsafe set operations */
+    /* @{ */
+    void set(index_t i, tag_t t)
+    {
+        index = i;
+        tag = t;
+    }
+
+    void set_index(index_t i)
+    {
+        index = i;
+    }
+
+    void set_tag(tag_t t)
+    {
+        tag = t;
+    }
+    /* @} */
+
+    index_t get_index(void) const
+    {
+        return index_t(index);
+    }
+
+    tag_t get_tag(void) const
+    {
+        return tag;
+    }
+
+    bool operator== (tagged_index const & rhs) const
+    {
+        return (index == rhs.index) && (tag == rhs.tag);
+    }
+
+    bool operator!= (tagged_index const & rhs) const
+    {
+        return !operator==(rhs);
+    }
+
+private:
+    /* the index is stored with the width of the tag, so the struct has no padding bytes, which would take part in
+     * the comparison of compare_exchange, but are not preserved by copies */
+    tag_t index;
+    tag_t tag;
+};
+
+/* smallest tagged_index, which can address the nodes 1 to max_index and leaves the largest index unused, so
+ * containers can use it as marker */
+template <std::size_t max_index>
+struct select_tagged_index
+{
+    BOOST_STATIC_ASSERT(max_index < 0xffffffffu);
+
+    typedef typename mpl::if_c<(max_index < 0xffffu), boost::uint16_t, boost::uint32_t>::type index_t;
+    typedef tagged_index<index_t> type;
+
+    /* link from one node to the next. its tag only changes, when this node is reused, so like the 16bit tags of
+     * tagged_ptr with pointer compression, it has the width of the index. a link of a container with less than 65535
+     * nodes fits into a 32bit word */
+    typedef tagged_index<index_t, index_t> link_type;
+
+    BOOST_STATIC_ASSERT(sizeof(type) == sizeof(boost::uint64_t));
+    BOOST_STATIC_ASSERT(sizeof(link_type) == 2 * sizeof(index_t));
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_TAGGED_INDEX_HPP_INCLUDED */
@@ -29,9 +29,8 @@ struct BOOST_LOCKFREE_DCAS_ALIGNMENT tagged_ptr
     tagged_ptr(void)//: ptr(0), tag(0)
     {}
 
-    tagged_ptr(tagged_ptr const & p):
-        ptr(p.ptr), tag(p.tag)
-    {}
+    /* copy constructor and assignment operator are implicitly defined: tagged_ptr has to be trivially
+     * copyable to be used with std::atomic */
 
     explicit tagged_ptr(T * p):
         ptr(p), tag(0)
@@ -43,12 +42,6 @@ struct BOOST_LOCKFREE_DCAS_ALIGNMENT tagged_ptr
 
     /** unsafe set operation */
     /* @{ */
-    tagged_ptr& operator= (tagged_ptr const & p)
-    {
-        set(p.ptr, p.tag);
-        return *this;
-    }
-
     void set(T * p, tag_t t)
     {
         ptr = p;
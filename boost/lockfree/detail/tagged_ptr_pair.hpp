@@ -95,17 +95,11 @@ struct BOOST_LOCKFREE_DCAS_ALIGNMENT tagged_ptr_pair
     tagged_ptr_pair(Left* lptr, Right* rptr, IntegralL ltag, IntegralR rtag):
         pair_(pack_ptr_pair(lptr, rptr, ltag, rtag)) {}
 
-    /** copy constructors */
-    tagged_ptr_pair(tagged_ptr_pair const& p): pair_(p.pair_) {}
-
     tagged_ptr_pair(Left* lptr, Right* rptr):
         pair_(pack_ptr_pair(lptr, rptr, 0, 0)) {}
 
     /** unsafe set operations */
     /* @{ */
-    void operator= (tagged_ptr_pair const& p)
-    { pair_ = p.pair_; }
-
     void set(Left* lptr, Right* rptr)
     { pair_ = pack_ptr_pair(lptr, rptr, 0, 0); }
 
@@ -276,25 +270,11 @@ struct BOOST_LOCKFREE_DCAS_ALIGNMENT tagged_ptr_pair
     tagged_ptr_pair(Left* lptr, Right* rptr, IntegralL ltag, IntegralR rtag)
     { pack_ptr_pair(pair_, lptr, rptr, ltag, rtag); }
 
-    /** copy constructors */
-    tagged_ptr_pair(tagged_ptr_pair const& p)
-    {
-        pair_.left = p.pair_.left;
-        pair_.right = p.pair_.right;
-    }
-    
     tagged_ptr_pair(Left* lptr, Right* rptr)
     { pack_ptr_pair(pair_, lptr, rptr, 0, 0); }
 
     /** unsafe set operations */
     /* @{ */
-    tagged_ptr_pair& operator= (tagged_ptr_pair const& p)
-    {
-        pair_.left = p.pair_.left;
-        pair_.right = p.pair_.right;
-        return *this;
-    }
-
     void set(Left* lptr, Right* rptr)
     { pack_ptr_pair(pair_, lptr, rptr, 0, 0); }
 
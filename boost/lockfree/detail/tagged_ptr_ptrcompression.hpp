@@ -65,10 +65,8 @@ public:
         ptr(0)
     {}
 
-    /** copy constructor */
-    tagged_ptr(tagged_ptr const & p):
-        ptr(p.ptr)
-    {}
+    /* copy constructor and assignment operator are implicitly defined: tagged_ptr has to be trivially
+     * copyable to be used with std::atomic */
 
     explicit tagged_ptr(T * p):
         ptr(pack_ptr(p, 0))
@@ -80,12 +78,6 @@ public:
 
     /** unsafe set operation */
     /* @{ */
-    tagged_ptr& operator= (tagged_ptr const & p)
-    {
-        ptr = p.ptr;
-        return *this;
-    }
-
     void set(T * p, tag_t t)
     {
         ptr = pack_ptr(p, t);
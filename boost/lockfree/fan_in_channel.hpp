@@ -0,0 +1,388 @@
+//  multi-producer/single-consumer channel, composed of single-producer/single-consumer ringbuffers
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_FAN_IN_CHANNEL_HPP_INCLUDED
+#define BOOST_LOCKFREE_FAN_IN_CHANNEL_HPP_INCLUDED
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+#include <boost/lockfree/detail/sequence.hpp>
+
+#include <boost/assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/smart_ptr/scoped_array.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+namespace boost
+{
+namespace lockfree
+{
+
+/** fairness policy of the fan_in_channel: the consumer serves the non-empty producers in turn */
+struct round_robin
+{};
+
+/** fairness policy of the fan_in_channel: the consumer serves the producer with the oldest element first. elements
+ *  are stamped with the number of elements, which the consumer has dequeued, so elements enqueued between two dequeue
+ *  operations are considered to be of the same age. */
+struct oldest_first
+{};
+
+namespace detail
+{
+
+template <typename T>
+struct stamped_element
+{
+    std::size_t epoch;
+    T data;
+};
+
+/* one bit per producer, set while the ringbuffer of the producer may contain elements */
+class fan_in_bitmap:
+    boost::noncopyable
+{
+    typedef std::size_t size_t;
+    static const size_t bits_per_word = sizeof(size_t) * 8;
+
+    size_t size_;
+    scoped_array<detail::atomic<size_t> > words_;
+
+    static size_t find_first_set(size_t word)
+    {
+#ifdef __GNUC__
+        return __builtin_ctzl(word);
+#else
+        size_t ret = 0;
+        while (!(word & 1)) {
+            word >>= 1;
+            ++ret;
+        }
+        return ret;
+#endif
+    }
+
+public:
+    explicit fan_in_bitmap(size_t size):
+        size_(size), words_(new detail::atomic<size_t>[(size + bits_per_word - 1) / bits_per_word])
+    {
+        for (size_t i = 0; i != (size + bits_per_word - 1) / bits_per_word; ++i)
+            words_[i].store(0, memory_order_relaxed);
+    }
+
+    bool test(size_t index) const
+    {
+        return words_[index / bits_per_word].load(memory_order_relaxed) & (size_t(1) << (index % bits_per_word));
+    }
+
+    void set(size_t index)
+    {
+        words_[index / bits_per_word].fetch_or(size_t(1) << (index % bits_per_word), memory_order_relaxed);
+    }
+
+    void clear(size_t index)
+    {
+        words_[index / bits_per_word].fetch_and(~(size_t(1) << (index % bits_per_word)), memory_order_relaxed);
+    }
+
+    /* index of the first set bit at or after start, or size() if there is none */
+    size_t find_next(size_t start) const
+    {
+        if (start >= size_)
+            return size_;
+
+        size_t word_index = start / bits_per_word;
+        size_t word = words_[word_index].load(memory_order_relaxed) & (~size_t(0) << (start % bits_per_word));
+
+        for (;;) {
+            if (word) {
+                size_t ret = word_index * bits_per_word + find_first_set(word);
+                return ret < size_ ? ret : size_;
+            }
+
+            ++word_index;
+            if (word_index * bits_per_word >= size_)
+                return size_;
+            word = words_[word_index].load(memory_order_relaxed);
+        }
+    }
+
+    size_t size(void) const
+    {
+        return size_;
+    }
+};
+
+} /* namespace detail */
+
+/** The fan_in_channel class provides a multi-producer/single-consumer channel. Each producer registers with the
+ *  channel and owns a single-producer/single-consumer ringbuffer, so producers never contend on a shared cache line.
+ *  The consumer polls the ringbuffers according to the fairness Policy, which is either round_robin or oldest_first,
+ *  and uses a bitmap of the non-empty ringbuffers to skip idle producers.
+ *
+ *  Each producer index must only be used by a single thread.
+ *
+ * */
+template <typename T, typename Policy = round_robin>
+class fan_in_channel:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+
+    static const bool stamped = boost::is_same<Policy, oldest_first>::value;
+    typedef typename boost::mpl::if_c<stamped, detail::stamped_element<T>, T>::type element_type;
+    typedef ringbuffer<element_type, 0> ringbuffer_type;
+
+    struct lookahead
+    {
+        bool valid;
+        element_type element;
+
+        lookahead(void):
+            valid(false)
+        {}
+    };
+
+    std::vector<ringbuffer_type*> rings_;
+    detail::fan_in_bitmap non_empty_;
+    detail::atomic<size_t> producer_count_;
+
+    /* consumer state */
+    detail::padded_sequence epoch_; /* number of dequeued elements, read by the producers of a stamped channel */
+    size_t cursor_;
+    scoped_array<lookahead> lookahead_;
+
+    static element_type make_element(T const & t, size_t epoch, boost::mpl::true_)
+    {
+        element_type ret;
+        ret.epoch = epoch;
+        ret.data = t;
+        return ret;
+    }
+
+    static element_type make_element(T const & t, size_t, boost::mpl::false_)
+    {
+        return t;
+    }
+
+    static T const & get_data(element_type const & element)
+    {
+        return get_data(element, boost::mpl::bool_<stamped>());
+    }
+
+    static T const & get_data(element_type const & element, boost::mpl::true_)
+    {
+        return element.data;
+    }
+
+    static T const & get_data(element_type const & element, boost::mpl::false_)
+    {
+        return element;
+    }
+
+    /* dequeue from a ringbuffer, whose bit is set. if the ringbuffer is empty, the bit is cleared. the full fence
+     * pairs with the fence in enqueue: either the producer sees the cleared bit and sets it again, or the consumer
+     * sees the element on the second attempt */
+    bool fetch(size_t index, element_type * ret)
+    {
+        if (rings_[index]->dequeue(ret))
+            return true;
+
+        non_empty_.clear(index);
+        detail::atomic_thread_fence(memory_order_seq_cst);
+
+        if (rings_[index]->dequeue(ret)) {
+            non_empty_.set(index);
+            return true;
+        }
+        return false;
+    }
+
+    /* used in the initializer list, so no member is constructed for an empty channel */
+    static size_t check_max_producers(size_t max_producers)
+    {
+        if (max_producers == 0)
+            throw std::invalid_argument("fan_in_channel: max_producers must not be zero");
+        return max_producers;
+    }
+
+    bool dequeue(T * ret, round_robin)
+    {
+        const size_t size = non_empty_.size();
+        const size_t start = (cursor_ + 1) % size;
+
+        /* scan [start, size), then wrap around to [0, start) */
+        size_t end = size;
+        for (size_t index = non_empty_.find_next(start);; index = non_empty_.find_next(index + 1)) {
+            if (index >= end) {
+                if (end == start || start == 0)
+                    return false;
+                end = start;
+                index = non_empty_.find_next(0);
+                if (index >= end)
+                    return false;
+            }
+
+            element_type element;
+            if (fetch(index, &element)) {
+                *ret = get_data(element);
+                cursor_ = index;
+                return true;
+            }
+        }
+    }
+
+    bool dequeue(T * ret, oldest_first)
+    {
+        const size_t size = non_empty_.size();
+
+        /* one element of lookahead per ringbuffer, so that the stamps of the heads can be compared */
+        for (size_t index = non_empty_.find_next(0); index != size; index = non_empty_.find_next(index + 1)) {
+            lookahead & l = lookahead_[index];
+            if (!l.valid)
+                l.valid = fetch(index, &l.element);
+        }
+
+        size_t oldest = size;
+        const size_t producers = std::min(producer_count_.load(memory_order_acquire), size);
+        for (size_t i = 0; i != producers; ++i) {
+            /* start behind the last served producer, so that equal stamps are served in turn */
+            size_t index = (cursor_ + 1 + i) % producers;
+            lookahead & l = lookahead_[index];
+            if (l.valid && (oldest == size || std::ptrdiff_t(l.element.epoch - lookahead_[oldest].element.epoch) < 0))
+                oldest = index;
+        }
+
+        if (oldest == size)
+            return false;
+
+        *ret = get_data(lookahead_[oldest].element);
+        lookahead_[oldest].valid = false;
+        cursor_ = oldest;
+        epoch_.value.store(epoch_.value.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        return true;
+    }
+#endif
+
+public:
+    /** Constructs a channel for up to max_producers producers, each with a ringbuffer of ring_size elements.
+     *
+     * \throws std::invalid_argument, if max_producers is zero
+     *
+     * \note All ringbuffers are allocated by the constructor, registering a producer does not allocate memory.
+     * */
+    fan_in_channel(size_t max_producers, size_t ring_size):
+        non_empty_(check_max_producers(max_producers)), producer_count_(0), cursor_(max_producers - 1),
+        lookahead_(stamped ? new lookahead[max_producers] : 0)
+    {
+        rings_.reserve(max_producers);
+        try {
+            for (size_t i = 0; i != max_producers; ++i)
+                rings_.push_back(new ringbuffer_type(ring_size));
+        }
+        catch (...) {
+            for (size_t i = 0; i != rings_.size(); ++i)
+                delete rings_[i];
+            throw;
+        }
+    }
+
+    ~fan_in_channel(void)
+    {
+        for (size_t i = 0; i != rings_.size(); ++i)
+            delete rings_[i];
+    }
+
+    /** Registers a producer.
+     *
+     * \return index of the producer, which has to be passed to enqueue
+     * \throws std::length_error, if max_producers producers have already been registered
+     *
+     * \note Thread-safe and lock-free
+     * */
+    size_t register_producer(void)
+    {
+        size_t index = producer_count_.fetch_add(1, memory_order_acq_rel);
+        if (index >= rings_.size())
+            throw std::length_error("fan_in_channel: too many producers");
+        return index;
+    }
+
+    //! \return maximum number of producers
+    size_t max_producers(void) const
+    {
+        return rings_.size();
+    }
+
+    /** Enqueues object t to the ringbuffer of the given producer. Enqueueing may fail, if this ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking, if each producer index is used by a single thread. The bitmap is only
+     *       modified, if the ringbuffer has been marked as empty by the consumer.
+     * */
+    bool enqueue(size_t producer, T const & t)
+    {
+        BOOST_ASSERT(producer < rings_.size());
+        const size_t epoch = stamped ? epoch_.value.load(memory_order_relaxed) : 0;
+        if (!rings_[producer]->enqueue(make_element(t, epoch, boost::mpl::bool_<stamped>())))
+            return false;
+
+        detail::atomic_thread_fence(memory_order_seq_cst);
+        if (!non_empty_.test(producer))
+            non_empty_.set(producer);
+        return true;
+    }
+
+    /** Dequeue object from the channel, choosing the producer according to the fairness policy.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if all ringbuffers were empty.
+     *
+     * \note Thread-safe and non-blocking, if called by a single thread
+     * */
+    bool dequeue(T * ret)
+    {
+        return dequeue(ret, Policy());
+    }
+
+    /**
+     * \return true, if the channel is empty.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        for (size_t i = 0; i != rings_.size(); ++i) {
+            if (!rings_[i]->empty())
+                return false;
+            if (stamped && lookahead_[i].valid)
+                return false;
+        }
+        return true;
+    }
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return producer_count_.is_lock_free();
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_FAN_IN_CHANNEL_HPP_INCLUDED */
@@ -15,12 +15,15 @@
 #ifndef BOOST_LOCKFREE_FIFO_HPP_INCLUDED
 #define BOOST_LOCKFREE_FIFO_HPP_INCLUDED
 
-#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/policies.hpp>
 
+#include <boost/mpl/if.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <memory>               /* std::auto_ptr */
 #include <boost/scoped_ptr.hpp>
@@ -35,7 +38,87 @@ namespace lockfree
 namespace detail
 {
 
-template <typename T, typename freelist_t, typename Alloc>
+template <typename T, typename Node>
+struct fifo_node_base
+{
+    typedef tagged_ptr<Node> tagged_ptr_t;
+    typedef typename tagged_ptr_t::tag_t tag_t;
+
+    fifo_node_base(T const & v, tag_t next_tag):
+        next(tagged_ptr_t(NULL, next_tag)), data(v)
+    {}
+
+    fifo_node_base (void):
+        next(tagged_ptr_t(NULL, 0))
+    {}
+
+    /* constructs a node in memory, which may have been used by a node before. the tag of the next pointer is
+     * incremented to avoid the ABA problem. it is read before the node is constructed, because the constructor
+     * initializes the next pointer */
+    static Node * construct(Node * chunk, T const & v)
+    {
+        tag_t next_tag = chunk->next.load(memory_order_relaxed).get_tag() + 1;
+        return new(chunk) Node(v, next_tag);
+    }
+
+    detail::atomic<tagged_ptr_t> next;
+    T data;
+};
+
+template <typename T, typename node_layout>
+struct fifo_node;
+
+template <typename T>
+struct BOOST_LOCKFREE_CACHELINE_ALIGNMENT fifo_node<T, padded_node_t>:
+    fifo_node_base<T, fifo_node<T, padded_node_t> >
+{
+    fifo_node(T const & v, typename fifo_node::tag_t next_tag):
+        fifo_node_base<T, fifo_node>(v, next_tag)
+    {}
+
+    fifo_node(void)
+    {}
+};
+
+template <typename T>
+struct fifo_node<T, packed_node_t>:
+    fifo_node_base<T, fifo_node<T, packed_node_t> >
+{
+    fifo_node(T const & v, typename fifo_node::tag_t next_tag):
+        fifo_node_base<T, fifo_node>(v, next_tag)
+    {}
+
+    fifo_node(void)
+    {}
+};
+
+/* layout policy of the compact_fifo: nodes are packed, head and tail share a cache line and the dummy node is
+ * installed by the first enqueue operation */
+struct compact_layout_t
+{
+    typedef node_layout_category policy_category;
+    typedef compact_layout_t type;
+};
+
+/* head and tail of a fifo, padded to separate cache lines */
+template <typename TaggedPtr, bool Padded>
+struct fifo_anchor
+{
+    detail::atomic<TaggedPtr> head_;
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(TaggedPtr);
+    char padding1[padding_size];
+    detail::atomic<TaggedPtr> tail_;
+    char padding2[padding_size];
+};
+
+template <typename TaggedPtr>
+struct fifo_anchor<TaggedPtr, false>
+{
+    detail::atomic<TaggedPtr> head_;
+    detail::atomic<TaggedPtr> tail_;
+};
+
+template <typename T, typename Policies>
 class fifo:
     boost::noncopyable
 {
@@ -43,47 +126,88 @@ private:
 #ifndef BOOST_DOXYGEN_INVOKED
     BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
 
-    struct BOOST_LOCKFREE_CACHELINE_ALIGNMENT node
-    {
-        typedef tagged_ptr<node> tagged_ptr_t;
-
-        node(T const & v):
-            data(v)
-        {
-            /* increment tag to avoid ABA problem */
-            tagged_ptr_t old_next = next.load(memory_order_relaxed);
-            tagged_ptr_t new_next (NULL, old_next.get_tag()+1);
-            next.store(new_next, memory_order_release);
-        }
+    typedef typename Policies::freelist_t freelist_t;
+    typedef typename Policies::allocator_t Alloc;
+    typedef typename Policies::backoff_t backoff_t;
 
-        node (void):
-            next(tagged_ptr_t(NULL, 0))
-        {}
+    static const bool compact = boost::is_same<typename Policies::node_layout_t, compact_layout_t>::value;
 
-        atomic<tagged_ptr_t> next;
-        T data;
-    };
+    /* the blocks of a shared pool are only aligned for the value type, so their nodes are always packed */
+    typedef typename mpl::if_c<compact || boost::is_same<freelist_t, shared_freelist_t>::value,
+                               packed_node_t,
+                               typename Policies::node_layout_t
+                              >::type node_layout_t;
+    typedef fifo_node<T, node_layout_t> node;
 
+    /* memory ordering:
+     * - a node is published by the release cas, which links it to the next pointer of the last node. next pointers
+     *   are loaded with acquire semantics, so the value and the next pointer of a node are visible before it is
+     *   dereferenced.
+     * - tail_ is advanced by release cas operations and loaded with acquire semantics. a thread, which advances
+     *   tail_, has obtained the new tail from an acquire load of a next pointer, so readers of tail_ transitively
+     *   synchronize with the thread, which has published the node.
+     * - dequeue reads the value of a node before the release cas on head_, which turns the node into the dummy node.
+     *   the thread, which later frees the node, has loaded head_ with acquire semantics, so the value is read before
+     *   the node can be reused.
+     * - the validation loads of head_ and tail_ follow acquire loads of next pointers, so they cannot be performed
+     *   before them.
+     * - the value, which a failed cas operation reads, is never dereferenced before it has been reloaded with acquire
+     *   semantics, so failure orderings are relaxed.
+     * */
     typedef tagged_ptr<node> tagged_ptr_t;
 
     typedef typename Alloc::template rebind<node>::other node_allocator;
-/*     typedef typename select_freelist<node, node_allocator, freelist_t>::type pool_t; */
-
-    typedef typename boost::mpl::if_<boost::is_same<freelist_t, caching_freelist_t>,
-                                     caching_freelist<node, node_allocator>,
-                                     static_freelist<node, node_allocator>
-                                     >::type pool_t;
+    typedef typename select_freelist<node, node_allocator, freelist_t, typename shared_pool<T>::type>::type pool_t;
 
     void initialize(void)
     {
+        if (compact) {
+            anchor_.head_.store(tagged_ptr_t(NULL, 0), memory_order_relaxed);
+            anchor_.tail_.store(tagged_ptr_t(NULL, 0), memory_order_release);
+            return;
+        }
+
         node * n = alloc_node();
         tagged_ptr_t dummy_node(n, 0);
-        head_.store(dummy_node, memory_order_relaxed);
-        tail_.store(dummy_node, memory_order_release);
+        anchor_.head_.store(dummy_node, memory_order_relaxed);
+        anchor_.tail_.store(dummy_node, memory_order_release);
+    }
+
+    /* a compact fifo installs its dummy node, when the first element is enqueued. the tail is set after the head, so
+     * the head of a fifo with a tail is valid */
+    bool install_dummy_node(void)
+    {
+        tagged_ptr_t head = anchor_.head_.load(memory_order_acquire);
+
+        if (!head.get_ptr()) {
+            node * dummy = pool.allocate();
+            if (dummy == 0)
+                return false;
+            new(dummy) node();
+
+            tagged_ptr_t new_head(dummy, head.get_tag() + 1);
+            if (anchor_.head_.compare_exchange_strong(head, new_head, memory_order_release, memory_order_acquire))
+                head = new_head;
+            else
+                dealloc_node(dummy); /* another thread has installed its dummy node */
+        }
+
+        tagged_ptr_t tail = anchor_.tail_.load(memory_order_acquire);
+        if (!tail.get_ptr())
+            anchor_.tail_.compare_exchange_strong(tail, tagged_ptr_t(head.get_ptr(), tail.get_tag() + 1),
+                                                  memory_order_release, memory_order_relaxed);
+        return true;
     }
 #endif
 
 public:
+#ifdef BOOST_DOXYGEN_INVOKED
+    //! node_pool, which can be shared by fifos, stacks and deques with the shared_freelist_t policy and the same value size
+    typedef implementation_defined pool_type;
+#else
+    typedef typename shared_pool<T>::type pool_type;
+#endif
+
     /**
      * \return true, if implementation is lock-free.
      *
@@ -91,12 +215,12 @@ public:
      * */
     bool is_lock_free (void) const
     {
-        return head_.is_lock_free();
+        return anchor_.head_.is_lock_free();
     }
 
-    //! Construct fifo, initially allocates 128 nodes
+    //! Construct fifo, initially allocates 128 nodes, or capacity + 1 nodes, if the capacity policy is given
     fifo(void):
-        pool(128)
+        pool(Policies::has_capacity ? Policies::capacity + 1 : 128)
     {
         initialize();
     }
@@ -108,6 +232,16 @@ public:
         initialize();
     }
 
+    /** Construct fifo, which allocates its nodes from a shared node pool.
+     *
+     * \pre the freelist policy is shared_freelist_t, the pool outlives the fifo
+     * */
+    explicit fifo(pool_type & shared_pool):
+        pool(shared_pool)
+    {
+        initialize();
+    }
+
     /** Destroys fifo, free all nodes from freelist.
      *
      *  \warning not threadsafe
@@ -115,16 +249,13 @@ public:
      * */
     ~fifo(void)
     {
-        if (!empty())
-        {
-            T dummy;
-            for(;;)
-            {
-                if (!dequeue(&dummy))
-                    break;
-            }
-        }
-        dealloc_node(head_.load(memory_order_relaxed).get_ptr());
+        T dummy;
+        while (unsynchronized_dequeue(&dummy))
+            ;
+
+        node * head = anchor_.head_.load(memory_order_relaxed).get_ptr();
+        if (head)
+            dealloc_node_unsynchronized(head);
     }
 
     /**
@@ -134,7 +265,7 @@ public:
      * */
     bool empty(void)
     {
-        return head_.load().get_ptr() == tail_.load().get_ptr();
+        return anchor_.head_.load().get_ptr() == anchor_.tail_.load().get_ptr();
     }
 
     /** Enqueues object t to the fifo. Enqueueing may fail, if the freelist is not able to allocate a new fifo node.
@@ -146,30 +277,99 @@ public:
      * */
     bool enqueue(T const & t)
     {
+        bool was_idle;
+        return enqueue_notify(t, was_idle);
+    }
+
+    /** Enqueues object t to the fifo. Enqueueing may fail, if the freelist is not able to allocate a new fifo node.
+     *
+     * If the fifo has been marked as idle by try_sleep, was_idle is set to true, i.e. the caller is responsible for
+     * waking up the consumer. Exactly one enqueue operation observes the idle fifo.
+     *
+     * \returns true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if node needs to be allocated from the operating system
+     * */
+    bool enqueue_notify(T const & t, bool & was_idle)
+    {
+        if (compact && unlikely(!anchor_.tail_.load(memory_order_acquire).get_ptr()) && !install_dummy_node())
+            return false;
+
         node * n = alloc_node(t);
 
         if (n == NULL)
             return false;
 
+        backoff_t backoff;
         for (;;)
         {
-            tagged_ptr_t tail = tail_.load(memory_order_acquire);
+            tagged_ptr_t tail = anchor_.tail_.load(memory_order_acquire);
             tagged_ptr_t next = tail->next.load(memory_order_acquire);
             node * next_ptr = next.get_ptr();
 
-            tagged_ptr_t tail_tmp = tail_.load(memory_order_acquire);
+            tagged_ptr_t tail_tmp = anchor_.tail_.load(memory_order_acquire);
             if (likely(tail == tail_tmp))
             {
-                if (next_ptr == 0)
+                if (next_ptr == 0 || next_ptr == idle_marker())
                 {
-                    if ( tail->next.compare_exchange_strong(next, tagged_ptr_t(n, next.get_tag() + 1)) )
+                    if ( tail->next.compare_exchange_weak(next, tagged_ptr_t(n, next.get_tag() + 1),
+                                                          memory_order_release, memory_order_relaxed) )
                     {
-                        tail_.compare_exchange_strong(tail, tagged_ptr_t(n, tail.get_tag() + 1));
+                        anchor_.tail_.compare_exchange_strong(tail, tagged_ptr_t(n, tail.get_tag() + 1),
+                                                      memory_order_release, memory_order_relaxed);
+                        was_idle = (next_ptr != 0);
                         return true;
                     }
+                    backoff();
                 }
                 else
-                    tail_.compare_exchange_strong(tail, tagged_ptr_t(next_ptr, tail.get_tag() + 1));
+                    anchor_.tail_.compare_exchange_weak(tail, tagged_ptr_t(next_ptr, tail.get_tag() + 1),
+                                                memory_order_release, memory_order_relaxed);
+            }
+        }
+    }
+
+    /** Marks the fifo as idle, if it is empty. The idle state is stored in the next pointer of the last node, so it
+     *  does not require an additional atomic variable.
+     *
+     * \returns true, if the fifo has been marked as idle. In this case the next enqueue_notify operation sets its
+     *          was_idle argument. false, if the fifo is not empty.
+     *
+     * \note Thread-safe and non-blocking. Only the thread, which is woken up by the producer, should call try_sleep.
+     * */
+    bool try_sleep(void)
+    {
+        for (;;)
+        {
+            tagged_ptr_t head = anchor_.head_.load(memory_order_acquire);
+            tagged_ptr_t tail = anchor_.tail_.load(memory_order_acquire);
+            if (compact && unlikely(!head.get_ptr() || !tail.get_ptr())) {
+                /* the idle marker requires a dummy node */
+                if (!install_dummy_node())
+                    return false;
+                continue;
+            }
+
+            if (head.get_ptr() != tail.get_ptr())
+                return false;
+
+            tagged_ptr_t next = tail->next.load(memory_order_acquire);
+            node * next_ptr = next.get_ptr();
+
+            tagged_ptr_t tail_tmp = anchor_.tail_.load(memory_order_acquire);
+            if (likely(tail == tail_tmp))
+            {
+                if (next_ptr == idle_marker())
+                    return true;
+                if (next_ptr != 0)
+                    return false;
+
+                /* the tag of the next pointer changes, if the node is dequeued, so the marker can only be placed
+                 * on the last node */
+                if (tail->next.compare_exchange_weak(next, tagged_ptr_t(idle_marker(), next.get_tag() + 1),
+                                                     memory_order_release, memory_order_relaxed))
+                    return true;
             }
         }
     }
@@ -185,42 +385,152 @@ public:
      * */
     bool dequeue (T * ret)
     {
+        backoff_t backoff;
         for (;;)
         {
-            tagged_ptr_t head = head_.load(memory_order_acquire);
-            tagged_ptr_t tail = tail_.load(memory_order_acquire);
+            tagged_ptr_t head = anchor_.head_.load(memory_order_acquire);
+            tagged_ptr_t tail = anchor_.tail_.load(memory_order_acquire);
+            if (compact && unlikely(!head.get_ptr() || !tail.get_ptr()))
+                return false; /* dummy node has not been installed, yet */
+
             tagged_ptr_t next = head->next.load(memory_order_acquire);
             node * next_ptr = next.get_ptr();
 
-            tagged_ptr_t head_tmp = head_.load(memory_order_acquire);
+            tagged_ptr_t head_tmp = anchor_.head_.load(memory_order_acquire);
             if (likely(head == head_tmp))
             {
                 if (head.get_ptr() == tail.get_ptr())
                 {
-                    if (next_ptr == 0)
+                    if (next_ptr == 0 || next_ptr == idle_marker())
                         return false;
-                    tail_.compare_exchange_strong(tail, tagged_ptr_t(next_ptr, tail.get_tag() + 1));
+                    anchor_.tail_.compare_exchange_weak(tail, tagged_ptr_t(next_ptr, tail.get_tag() + 1),
+                                                memory_order_release, memory_order_relaxed);
                 }
                 else
                 {
-                    if (next_ptr == 0) /* this check shouldn't be needed, but it crashes without :/ */
+                    if (next_ptr == 0 || next_ptr == idle_marker()) /* this check shouldn't be needed, but it crashes without :/ */
                         continue;
                     *ret = next_ptr->data;
-                    if (head_.compare_exchange_strong(head, tagged_ptr_t(next_ptr, head.get_tag() + 1)))
+                    if (anchor_.head_.compare_exchange_weak(head, tagged_ptr_t(next_ptr, head.get_tag() + 1),
+                                                    memory_order_release, memory_order_relaxed))
                     {
                         dealloc_node(head.get_ptr());
                         return true;
                     }
+                    backoff();
                 }
             }
         }
     }
 
+    /** \name unsynchronized operations
+     *
+     *  Variants of enqueue and dequeue, which use plain loads and stores instead of compare-and-swap loops, e.g. to
+     *  fill the fifo before the consumer threads are started or to drain it after they have been joined. They do not
+     *  report, whether the fifo has been idle.
+     *
+     *  \warning Not thread-safe. The caller guarantees, that no other thread accesses the fifo or its freelist, and
+     *           synchronizes with the threads, which access them later, e.g. by starting them afterwards.
+     * */
+    /* @{ */
+    bool unsynchronized_enqueue(T const & t)
+    {
+        if (compact && !anchor_.tail_.load(memory_order_relaxed).get_ptr() && !install_dummy_node())
+            return false;
+
+        node * n = alloc_node_unsynchronized(t);
+
+        if (n == NULL)
+            return false;
+
+        link_unsynchronized(n, n);
+        return true;
+    }
+
+    /** Enqueues the objects of the range [begin, end). The nodes are chained first and then linked to the fifo at once.
+     *
+     * \returns iterator to the first object, which has not been enqueued, because the freelist is not able to allocate
+     *          a new fifo node, or end.
+     * */
+    template <typename ConstIterator>
+    ConstIterator unsynchronized_enqueue(ConstIterator begin, ConstIterator end)
+    {
+        if (begin == end)
+            return begin;
+
+        if (compact && !anchor_.tail_.load(memory_order_relaxed).get_ptr() && !install_dummy_node())
+            return begin;
+
+        node * first = alloc_node_unsynchronized(*begin);
+        if (first == NULL)
+            return begin;
+
+        node * last = first;
+        for (++begin; begin != end; ++begin)
+        {
+            node * n = alloc_node_unsynchronized(*begin);
+            if (n == NULL)
+                break;
+
+            tagged_ptr_t next = last->next.load(memory_order_relaxed);
+            last->next.store(tagged_ptr_t(n, next.get_tag() + 1), memory_order_relaxed);
+            last = n;
+        }
+
+        link_unsynchronized(first, last);
+        return begin;
+    }
+
+    bool unsynchronized_dequeue (T * ret)
+    {
+        tagged_ptr_t head = anchor_.head_.load(memory_order_relaxed);
+        if (compact && !head.get_ptr())
+            return false;
+
+        node * next_ptr = head->next.load(memory_order_relaxed).get_ptr();
+
+        if (next_ptr == 0 || next_ptr == idle_marker())
+            return false;
+
+        *ret = next_ptr->data;
+        anchor_.head_.store(tagged_ptr_t(next_ptr, head.get_tag() + 1), memory_order_relaxed);
+        dealloc_node_unsynchronized(head.get_ptr());
+        return true;
+    }
+
+    /** Dequeues all objects of the fifo to the output iterator out.
+     *
+     * \returns number of dequeued objects
+     * */
+    template <typename OutputIterator>
+    std::size_t unsynchronized_dequeue_all(OutputIterator out)
+    {
+        std::size_t count = 0;
+        T element;
+        while (unsynchronized_dequeue(&element))
+        {
+            *out++ = element;
+            ++count;
+        }
+        return count;
+    }
+    /* @} */
+
 private:
 #ifndef BOOST_DOXYGEN_INVOKED
+    /* next pointer of the last node of an idle fifo. it never points to a node, the address of the fifo is used to
+     * obtain a distinct value */
+    node * idle_marker(void) const
+    {
+        return reinterpret_cast<node*>(const_cast<fifo*>(this));
+    }
+
+    /* only used by the constructors */
     node * alloc_node(void)
     {
-        node * chunk = pool.allocate();
+        node * chunk = pool.unsynchronized_allocate();
+        if (chunk == 0)
+            return 0;
         new(chunk) node();
         return chunk;
     }
@@ -228,8 +538,9 @@ private:
     node * alloc_node(T const & t)
     {
         node * chunk = pool.allocate();
-        new(chunk) node(t);
-        return chunk;
+        if (chunk == 0)
+            return 0;
+        return node::construct(chunk, t);
     }
 
     void dealloc_node(node * n)
@@ -238,45 +549,403 @@ private:
         pool.deallocate(n);
     }
 
-    atomic<tagged_ptr_t> head_;
-    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(tagged_ptr_t);
+    node * alloc_node_unsynchronized(T const & t)
+    {
+        node * chunk = pool.unsynchronized_allocate();
+        if (chunk == 0)
+            return 0;
+        return node::construct(chunk, t);
+    }
+
+    void dealloc_node_unsynchronized(node * n)
+    {
+        n->~node();
+        pool.unsynchronized_deallocate(n);
+    }
+
+    /* links the chain of nodes from first to last after the last node. without concurrent operations, tail_ refers to
+     * the last node, because each enqueue operation advances tail_ past its node before it returns */
+    void link_unsynchronized(node * first, node * last)
+    {
+        tagged_ptr_t tail = anchor_.tail_.load(memory_order_relaxed);
+        tagged_ptr_t next = tail->next.load(memory_order_relaxed);
+
+        tail->next.store(tagged_ptr_t(first, next.get_tag() + 1), memory_order_relaxed);
+        anchor_.tail_.store(tagged_ptr_t(last, tail.get_tag() + 1), memory_order_relaxed);
+    }
+
+    fifo_anchor<tagged_ptr_t, !compact> anchor_;
+
+    pool_t pool;
+#endif
+};
+
+/* node of a fifo with inline storage, linked by index */
+template <typename T, typename TaggedIndex>
+struct fixed_fifo_node
+{
+    typedef typename TaggedIndex::index_t index_t;
+    typedef typename TaggedIndex::tag_t tag_t;
+
+    fixed_fifo_node(T const & v, tag_t next_tag):
+        next(TaggedIndex(0, next_tag)), data(v)
+    {}
+
+    fixed_fifo_node(void):
+        next(TaggedIndex(0, 0))
+    {}
+
+    /* see fifo_node_base::construct */
+    static fixed_fifo_node * construct(fixed_fifo_node * chunk, T const & v)
+    {
+        tag_t next_tag = chunk->next.load(memory_order_relaxed).get_tag() + 1;
+        return new(chunk) fixed_fifo_node(v, next_tag);
+    }
+
+    detail::atomic<TaggedIndex> next;
+    T data;
+};
+
+/** fifo with a compile-time capacity, whose nodes are stored inside the fifo object.
+ *
+ *  It implements the same algorithm as the fifo with the same memory ordering, but nodes are linked by 16bit indices
+ *  with a 16bit tag, so each link fits into a 32bit word (64bit for more than 65533 elements). Head and tail are
+ *  tagged indices with a 32bit tag in a 64bit word. No memory is allocated from the heap.
+ * */
+template <typename T, std::size_t max_size, typename Backoff>
+class fixed_fifo:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+
+    /* max_size elements and the dummy node */
+    typedef typename select_tagged_index<max_size + 1>::type tagged_index_t;
+    typedef typename select_tagged_index<max_size + 1>::link_type link_t;
+    typedef typename tagged_index_t::index_t index_t;
+    typedef fixed_fifo_node<T, link_t> node;
+    typedef fixed_freelist<node, max_size + 1> pool_t;
+
+    /* next index of the last node of an idle fifo, it never refers to a node */
+    static const index_t idle_marker = index_t(-1);
+
+    node * get_node(index_t i) const
+    {
+        return pool.pointer(i);
+    }
+#endif
+
+public:
+    //! containers with inline storage cannot share a node pool
+    struct pool_type;
+
+    //! \copydoc boost::lockfree::detail::fifo::is_lock_free
+    bool is_lock_free (void) const
+    {
+        return head_.is_lock_free();
+    }
+
+    //! Construct fifo. No memory is allocated.
+    fixed_fifo(void)
+    {
+        node * n = pool.unsynchronized_allocate();
+        new(n) node();
+        tagged_index_t dummy_node(pool.get_index(n), 0);
+        head_.store(dummy_node, memory_order_relaxed);
+        tail_.store(dummy_node, memory_order_release);
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::empty
+    bool empty(void)
+    {
+        return head_.load().get_index() == tail_.load().get_index();
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::enqueue
+    bool enqueue(T const & t)
+    {
+        bool was_idle;
+        return enqueue_notify(t, was_idle);
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::enqueue_notify
+    bool enqueue_notify(T const & t, bool & was_idle)
+    {
+        node * n = pool.allocate();
+
+        if (n == NULL)
+            return false;
+
+        node::construct(n, t);
+        index_t index = pool.get_index(n);
+
+        Backoff backoff;
+        for (;;)
+        {
+            tagged_index_t tail = tail_.load(memory_order_acquire);
+            node * tail_node = get_node(tail.get_index());
+            link_t next = tail_node->next.load(memory_order_acquire);
+            index_t next_index = next.get_index();
+
+            tagged_index_t tail_tmp = tail_.load(memory_order_acquire);
+            if (likely(tail == tail_tmp))
+            {
+                if (next_index == 0 || next_index == idle_marker)
+                {
+                    if ( tail_node->next.compare_exchange_weak(next, link_t(index, next.get_tag() + 1),
+                                                               memory_order_release, memory_order_relaxed) )
+                    {
+                        tail_.compare_exchange_strong(tail, tagged_index_t(index, tail.get_tag() + 1),
+                                                      memory_order_release, memory_order_relaxed);
+                        was_idle = (next_index != 0);
+                        return true;
+                    }
+                    backoff();
+                }
+                else
+                    tail_.compare_exchange_weak(tail, tagged_index_t(next_index, tail.get_tag() + 1),
+                                                memory_order_release, memory_order_relaxed);
+            }
+        }
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::try_sleep
+    bool try_sleep(void)
+    {
+        for (;;)
+        {
+            tagged_index_t head = head_.load(memory_order_acquire);
+            tagged_index_t tail = tail_.load(memory_order_acquire);
+            if (head.get_index() != tail.get_index())
+                return false;
+
+            node * tail_node = get_node(tail.get_index());
+            link_t next = tail_node->next.load(memory_order_acquire);
+            index_t next_index = next.get_index();
+
+            tagged_index_t tail_tmp = tail_.load(memory_order_acquire);
+            if (likely(tail == tail_tmp))
+            {
+                if (next_index == idle_marker)
+                    return true;
+                if (next_index != 0)
+                    return false;
+
+                if (tail_node->next.compare_exchange_weak(next, link_t(idle_marker, next.get_tag() + 1),
+                                                          memory_order_release, memory_order_relaxed))
+                    return true;
+            }
+        }
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::dequeue
+    bool dequeue (T * ret)
+    {
+        Backoff backoff;
+        for (;;)
+        {
+            tagged_index_t head = head_.load(memory_order_acquire);
+            tagged_index_t tail = tail_.load(memory_order_acquire);
+            link_t next = get_node(head.get_index())->next.load(memory_order_acquire);
+            index_t next_index = next.get_index();
+
+            tagged_index_t head_tmp = head_.load(memory_order_acquire);
+            if (likely(head == head_tmp))
+            {
+                if (head.get_index() == tail.get_index())
+                {
+                    if (next_index == 0 || next_index == idle_marker)
+                        return false;
+                    tail_.compare_exchange_weak(tail, tagged_index_t(next_index, tail.get_tag() + 1),
+                                                memory_order_release, memory_order_relaxed);
+                }
+                else
+                {
+                    if (next_index == 0 || next_index == idle_marker)
+                        continue;
+                    *ret = get_node(next_index)->data;
+                    if (head_.compare_exchange_weak(head, tagged_index_t(next_index, head.get_tag() + 1),
+                                                    memory_order_release, memory_order_relaxed))
+                    {
+                        pool.deallocate(get_node(head.get_index()));
+                        return true;
+                    }
+                    backoff();
+                }
+            }
+        }
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::unsynchronized_enqueue(T const &)
+    bool unsynchronized_enqueue(T const & t)
+    {
+        node * n = pool.unsynchronized_allocate();
+
+        if (n == NULL)
+            return false;
+
+        node::construct(n, t);
+        index_t index = pool.get_index(n);
+        link_unsynchronized(index, index);
+        return true;
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::unsynchronized_enqueue(ConstIterator, ConstIterator)
+    template <typename ConstIterator>
+    ConstIterator unsynchronized_enqueue(ConstIterator begin, ConstIterator end)
+    {
+        if (begin == end)
+            return begin;
+
+        node * last = pool.unsynchronized_allocate();
+        if (last == NULL)
+            return begin;
+
+        node::construct(last, *begin);
+        index_t first = pool.get_index(last);
+
+        for (++begin; begin != end; ++begin)
+        {
+            node * n = pool.unsynchronized_allocate();
+            if (n == NULL)
+                break;
+
+            node::construct(n, *begin);
+            link_t next = last->next.load(memory_order_relaxed);
+            last->next.store(link_t(pool.get_index(n), next.get_tag() + 1), memory_order_relaxed);
+            last = n;
+        }
+
+        link_unsynchronized(first, pool.get_index(last));
+        return begin;
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::unsynchronized_dequeue
+    bool unsynchronized_dequeue (T * ret)
+    {
+        tagged_index_t head = head_.load(memory_order_relaxed);
+        index_t next_index = get_node(head.get_index())->next.load(memory_order_relaxed).get_index();
+
+        if (next_index == 0 || next_index == idle_marker)
+            return false;
+
+        *ret = get_node(next_index)->data;
+        head_.store(tagged_index_t(next_index, head.get_tag() + 1), memory_order_relaxed);
+        pool.unsynchronized_deallocate(get_node(head.get_index()));
+        return true;
+    }
+
+    //! \copydoc boost::lockfree::detail::fifo::unsynchronized_dequeue_all
+    template <typename OutputIterator>
+    std::size_t unsynchronized_dequeue_all(OutputIterator out)
+    {
+        std::size_t count = 0;
+        T element;
+        while (unsynchronized_dequeue(&element))
+        {
+            *out++ = element;
+            ++count;
+        }
+        return count;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    /* see fifo::link_unsynchronized */
+    void link_unsynchronized(index_t first, index_t last)
+    {
+        tagged_index_t tail = tail_.load(memory_order_relaxed);
+        node * tail_node = get_node(tail.get_index());
+        link_t next = tail_node->next.load(memory_order_relaxed);
+
+        tail_node->next.store(link_t(first, next.get_tag() + 1), memory_order_relaxed);
+        tail_.store(tagged_index_t(last, tail.get_tag() + 1), memory_order_relaxed);
+    }
+
+    detail::atomic<tagged_index_t> head_;
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(tagged_index_t);
     char padding1[padding_size];
-    atomic<tagged_ptr_t> tail_;
+    detail::atomic<tagged_index_t> tail_;
     char padding2[padding_size];
 
     pool_t pool;
 #endif
 };
 
+/* fifos with a capacity policy and a fixed-sized freelist use inline storage */
+template <typename T, typename Policies>
+struct select_fifo
+{
+    static const bool inline_storage = Policies::has_capacity &&
+                                       boost::is_same<typename Policies::freelist_t, static_freelist_t>::value;
+
+    typedef typename mpl::if_c<inline_storage,
+                               fixed_fifo<T, Policies::capacity, typename Policies::backoff_t>,
+                               fifo<T, Policies>
+                              >::type type;
+};
+
 } /* namespace detail */
 
 /** The fifo class provides a multi-writer/multi-reader fifo, enqueueing and dequeueing is lockfree,
  *  construction/destruction has to be synchronized. It uses a freelist for memory management,
  *  freed nodes are pushed to the freelist, but not returned to the os. This may result in leaking memory.
  *
- *  The memory management of the fifo can be controlled via its freelist_t template argument. Two different
- *  freelists can be used. struct caching_freelist_t selects a caching freelist, which can allocate more nodes
- *  from the operating system, and struct static_freelist_t uses a fixed-sized freelist. With a fixed-sized
- *  freelist, the enqueue operation may fail, while with a caching freelist, the enqueue operation may block.
+ *  The fifo is configured by up to five policy arguments, which can be given in any order:
+ *
+ *  - The memory management is controlled via a freelist policy. struct caching_freelist_t selects a caching freelist,
+ *    which can allocate more nodes from the operating system, and struct static_freelist_t uses a fixed-sized
+ *    freelist. With a fixed-sized freelist, the enqueue operation may fail, while with a caching freelist, the
+ *    enqueue operation may block. fixed_sized<true> and fixed_sized<false> select them by a boolean. struct
+ *    shared_freelist_t allocates the nodes from a node_pool of type pool_type, which is passed to the constructor and
+ *    can be shared with fifos, stacks and deques, whose value type has the same size and alignment. The nodes of
+ *    such a fifo are always packed.
+ *  - capacity<N> makes the default constructor allocate the nodes for N elements. Unless a freelist policy is given,
+ *    the fifo is fixed-sized. A fixed-sized fifo with a capacity policy stores its nodes inside the fifo object and
+ *    links them by 16bit or 32bit indices instead of tagged pointers, so it does not allocate any memory from the
+ *    heap. Its nodes are always packed.
+ *  - allocator<Alloc> allocates the nodes. For compatibility, the allocator can also be passed without the wrapper.
+ *  - The node layout policy selects the memory layout of the fifo nodes. With struct padded_node_t each node is aligned
+ *    to a cache line, which avoids false sharing between threads accessing neighboring nodes of a shallow fifo, but a
+ *    fifo<std::size_t> requires 64 bytes per element. struct packed_node_t stores several nodes per cache line, which
+ *    reduces the memory footprint and improves the cache locality of deep fifos.
+ *  - backoff<Backoff> is applied after a contended compare-and-swap. The default no_backoff retries immediately.
+ *
+ *  The positional form fifo<T, freelist_t, Alloc, node_layout> is still accepted.
+ *
+ *  During phases, in which a single thread accesses the fifo, e.g. while it is filled at startup or drained at
+ *  shutdown, unsynchronized_enqueue and unsynchronized_dequeue avoid the compare-and-swap operations.
  *
  *  \b Limitation: The fifo class is limited to PODs
  *
  * */
 template <typename T,
-          typename freelist_t = caching_freelist_t,
-          typename Alloc = std::allocator<T>
+          typename A0 = detail::no_policy,
+          typename A1 = detail::no_policy,
+          typename A2 = detail::no_policy,
+          typename A3 = detail::no_policy,
+          typename A4 = detail::no_policy
           >
 class fifo:
-    public detail::fifo<T, freelist_t, Alloc>
+    public detail::select_fifo<T, detail::container_policies<T, A0, A1, A2, A3, A4> >::type
 {
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::select_fifo<T, detail::container_policies<T, A0, A1, A2, A3, A4> >::type fifo_t;
+#endif
+
 public:
-    //! Construct fifo, initially allocates 128 nodes
+    //! \copydoc detail::fifo::fifo(void)
     fifo(void)
     {}
 
     //! Construct fifo with a number of initially allocated fifo nodes.
     explicit fifo(std::size_t initial_nodes):
-        detail::fifo<T, freelist_t, Alloc>(initial_nodes)
+        fifo_t(initial_nodes)
+    {}
+
+    //! \copydoc detail::fifo::fifo(pool_type&)
+    explicit fifo(typename fifo_t::pool_type & shared_pool):
+        fifo_t(shared_pool)
     {}
 };
 
@@ -285,12 +954,12 @@ public:
  *
  *  it supports dequeue operations to stl/boost-style smart pointers
  * */
-template <typename T, typename freelist_t, typename Alloc>
-class fifo<T*, freelist_t, Alloc>:
-    public detail::fifo<T*, freelist_t, Alloc>
+template <typename T, typename A0, typename A1, typename A2, typename A3, typename A4>
+class fifo<T*, A0, A1, A2, A3, A4>:
+    public detail::select_fifo<T*, detail::container_policies<T*, A0, A1, A2, A3, A4> >::type
 {
 #ifndef BOOST_DOXYGEN_INVOKED
-    typedef detail::fifo<T*, freelist_t, Alloc> fifo_t;
+    typedef typename detail::select_fifo<T*, detail::container_policies<T*, A0, A1, A2, A3, A4> >::type fifo_t;
 
     template <typename smart_ptr>
     bool dequeue_smart_ptr(smart_ptr & ptr)
@@ -305,7 +974,7 @@ class fifo<T*, freelist_t, Alloc>:
 #endif
 
 public:
-    //! Construct fifo, initially allocates 128 nodes
+    //! \copydoc detail::fifo::fifo(void)
     fifo(void)
     {}
 
@@ -314,6 +983,11 @@ public:
         fifo_t(initial_nodes)
     {}
 
+    //! \copydoc detail::fifo::fifo(pool_type&)
+    explicit fifo(typename fifo_t::pool_type & shared_pool):
+        fifo_t(shared_pool)
+    {}
+
     //! \copydoc detail::fifo::dequeue
     bool dequeue (T ** ret)
     {
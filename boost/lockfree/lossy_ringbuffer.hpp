@@ -0,0 +1,227 @@
+//  lock-free single-producer/single-consumer ringbuffer, which overwrites the oldest elements
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_LOSSY_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_LOSSY_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/array.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/smart_ptr/scoped_array.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+#include "detail/branch_hints.hpp"
+#include "detail/prefix.hpp"
+
+#include <cstring>
+
+namespace boost
+{
+namespace lockfree
+{
+
+namespace detail
+{
+
+/* every slot carries a sequence stamp: 2*n+1 while element n is written, 2*n+2 after element n has been written */
+template <typename T>
+struct lossy_ringbuffer_slot
+{
+    detail::atomic<std::size_t> sequence;
+    T data;
+
+    lossy_ringbuffer_slot(void):
+        sequence(0)
+    {}
+};
+
+template <typename T>
+class lossy_ringbuffer_internal:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+
+protected:
+    typedef std::size_t size_t;
+    typedef lossy_ringbuffer_slot<T> slot;
+
+private:
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(size_t);
+    detail::atomic<size_t> write_sequence_; /* number of enqueued elements, only read by the consumer after an overrun */
+    char padding1[padding_size]; /* force read_sequence and write_sequence to different cache lines */
+    size_t read_sequence_; /* owned by the consumer */
+    char padding2[padding_size];
+
+protected:
+    lossy_ringbuffer_internal(void):
+        write_sequence_(0), read_sequence_(0)
+    {}
+
+    void enqueue(T const & t, slot * buffer, size_t max_size)
+    {
+        const size_t sequence = write_sequence_.load(memory_order_relaxed);
+        slot & s = buffer[sequence % max_size];
+
+        s.sequence.store(2 * sequence + 1, memory_order_relaxed);
+        detail::atomic_thread_fence(memory_order_release);
+        std::memcpy(&s.data, &t, sizeof(T));
+        s.sequence.store(2 * sequence + 2, memory_order_release);
+
+        write_sequence_.store(sequence + 1, memory_order_release);
+    }
+
+    bool dequeue(T * ret, size_t * lost, slot * buffer, size_t max_size)
+    {
+        size_t skipped = 0;
+
+        for (;;) {
+            const size_t sequence = read_sequence_;
+            slot & s = buffer[sequence % max_size];
+
+            const size_t stamp = s.sequence.load(memory_order_acquire);
+            if (stamp < 2 * sequence + 2) {
+                /* element has not been written, yet */
+                if (lost)
+                    *lost = skipped;
+                return false;
+            }
+
+            if (likely(stamp == 2 * sequence + 2)) {
+                T data;
+                std::memcpy(&data, &s.data, sizeof(T));
+                detail::atomic_thread_fence(memory_order_acquire);
+
+                /* validate that the producer did not overwrite the slot during the copy */
+                if (likely(s.sequence.load(memory_order_relaxed) == stamp)) {
+                    *ret = data;
+                    read_sequence_ = sequence + 1;
+                    if (lost)
+                        *lost = skipped;
+                    return true;
+                }
+            }
+
+            /* overrun: skip to the oldest element, which the producer cannot be overwriting at the moment */
+            const size_t write_sequence = write_sequence_.load(memory_order_acquire);
+            size_t oldest = sequence + 1;
+            if (write_sequence >= sequence + max_size)
+                oldest = write_sequence + 1 - max_size;
+            skipped += oldest - sequence;
+            read_sequence_ = oldest;
+        }
+    }
+#endif
+
+public:
+    /**
+     * \return true, if ringbuffer is empty.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return write_sequence_.load(memory_order_relaxed) == read_sequence_;
+    }
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return write_sequence_.is_lock_free();
+    }
+};
+
+} /* namespace detail */
+
+/** The lossy_ringbuffer class provides a single-writer/single-reader ringbuffer, which never blocks or fails the
+ *  producer: if the ringbuffer is full, the oldest unread element is overwritten. The consumer detects overruns via
+ *  sequence stamps in the slots, skips to the oldest valid element and reports the number of lost elements.
+ *
+ *  The producer never reads any state of the consumer.
+ *
+ *  \b Limitation: The lossy_ringbuffer class is limited to PODs
+ *
+ * */
+template <typename T, size_t max_size>
+class lossy_ringbuffer:
+    public detail::lossy_ringbuffer_internal<T>
+{
+    typedef std::size_t size_t;
+    typedef detail::lossy_ringbuffer_internal<T> base_type;
+    boost::array<typename base_type::slot, max_size> array_;
+
+public:
+    /** Enqueues object t to the ringbuffer. If the ringbuffer is full, the oldest element is overwritten.
+     *
+     * \note Thread-safe and wait-free
+     * */
+    void enqueue(T const & t)
+    {
+        base_type::enqueue(t, array_.c_array(), max_size);
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret. If lost is not NULL,
+     * the number of elements, which have been overwritten before they could be dequeued, is written to it.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     */
+    bool dequeue(T * ret, size_t * lost = NULL)
+    {
+        return base_type::dequeue(ret, lost, array_.c_array(), max_size);
+    }
+};
+
+template <typename T>
+class lossy_ringbuffer<T, 0>:
+    public detail::lossy_ringbuffer_internal<T>
+{
+    typedef std::size_t size_t;
+    typedef detail::lossy_ringbuffer_internal<T> base_type;
+    size_t max_size_;
+    scoped_array<typename base_type::slot> array_;
+
+public:
+    //! Constructs a ringbuffer for max_size elements
+    explicit lossy_ringbuffer(size_t max_size):
+        max_size_(max_size), array_(new typename base_type::slot[max_size])
+    {}
+
+    /** Enqueues object t to the ringbuffer. If the ringbuffer is full, the oldest element is overwritten.
+     *
+     * \note Thread-safe and wait-free
+     * */
+    void enqueue(T const & t)
+    {
+        base_type::enqueue(t, array_.get(), max_size_);
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret. If lost is not NULL,
+     * the number of elements, which have been overwritten before they could be dequeued, is written to it.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     */
+    bool dequeue(T * ret, size_t * lost = NULL)
+    {
+        return base_type::dequeue(ret, lost, array_.get(), max_size_);
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_LOSSY_RINGBUFFER_HPP_INCLUDED */
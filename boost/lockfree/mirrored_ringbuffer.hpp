@@ -0,0 +1,163 @@
+//  lock-free single-producer/single-consumer ringbuffer on virtual memory mirrored storage
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_MIRRORED_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_MIRRORED_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/lockfree/ringbuffer.hpp>
+#include <boost/lockfree/detail/bulk_copy.hpp>
+#include <boost/lockfree/detail/mirrored_storage.hpp>
+
+#include <algorithm>
+
+namespace boost
+{
+namespace lockfree
+{
+
+/** The mirrored_ringbuffer class provides a single-writer/single-reader ringbuffer, whose storage is mapped twice,
+ *  back to back, in the virtual address space. Therefore the readable and the writable part of the buffer are always
+ *  contiguous, bulk operations never have to be split at the end of the buffer, and the buffer can be accessed in
+ *  place via prepare_read/commit_read and prepare_write/commit_write.
+ *
+ *  mirrored_ringbuffer<char> can be used as byte ringbuffer, e.g. for parsing a stream without copying it.
+ *
+ *  \b Limitation: The mirrored_ringbuffer class is limited to PODs. The buffer size is rounded up to a multiple of
+ *  the page size.
+ *
+ * */
+template <typename T>
+class mirrored_ringbuffer:
+    public detail::ringbuffer_internal<T>
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef detail::ringbuffer_internal<T> base_type;
+
+    detail::mirrored_storage<T> storage_;
+#endif
+
+public:
+    /** Constructs a ringbuffer for at least max_size elements
+     *
+     * \throws boost::system::system_error, if the mirrored mapping cannot be created
+     * */
+    explicit mirrored_ringbuffer(size_t max_size):
+        storage_(max_size)
+    {}
+
+    //! \return size of the buffer, after rounding it to a multiple of the page size
+    size_t max_size(void) const
+    {
+        return storage_.size();
+    }
+
+    /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * */
+    bool enqueue(T const & t)
+    {
+        return base_type::enqueue(t, storage_.data(), storage_.size());
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     */
+    bool dequeue(T * ret)
+    {
+        return base_type::dequeue(ret, storage_.data(), storage_.size());
+    }
+
+    /** Enqueues size objects from the array t to the ringbuffer, with a single contiguous copy.
+     *
+     *  Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return number of enqueued items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    size_t enqueue(T const * t, size_t size)
+    {
+        size_t available;
+        T * window = prepare_write(available);
+        size = std::min(size, available);
+        detail::copy_to_buffer(t, t + size, window, detail::is_large_transfer<T>(size));
+        commit_write(size);
+        return size;
+    }
+
+    /** Dequeue a maximum of size objects from ringbuffer, with a single contiguous copy.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return number of dequeued items
+     *
+     * */
+    size_t dequeue(T * ret, size_t size)
+    {
+        size_t available;
+        T const * window = prepare_read(available);
+        size = std::min(size, available);
+        detail::copy_from_buffer(window, window + size, ret, detail::is_large_transfer<T>(size));
+        commit_read(size);
+        return size;
+    }
+
+    /** Producer side of the zero-copy interface.
+     *
+     * \return pointer to the contiguous free part of the buffer, its number of elements is written to available.
+     *
+     * \note The elements are not visible to the consumer before commit_write is called.
+     * */
+    T * prepare_write(size_t & available)
+    {
+        return storage_.data() + base_type::prepare_write(available, storage_.size());
+    }
+
+    /** Publishes count elements, which have been written to the window returned by prepare_write.
+     *
+     * \pre count must not exceed the available size returned by the preceding prepare_write
+     * */
+    void commit_write(size_t count)
+    {
+        base_type::commit_write(count, storage_.size());
+    }
+
+    /** Consumer side of the zero-copy interface.
+     *
+     * \return pointer to the contiguous readable part of the buffer, its number of elements is written to available.
+     *
+     * \note The window stays valid until commit_read is called.
+     * */
+    T const * prepare_read(size_t & available)
+    {
+        return storage_.data() + base_type::prepare_read(available, storage_.size());
+    }
+
+    /** Releases count elements at the start of the window returned by prepare_read.
+     *
+     * \pre count must not exceed the available size returned by the preceding prepare_read
+     * */
+    void commit_read(size_t count)
+    {
+        base_type::commit_read(count, storage_.size());
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_MIRRORED_RINGBUFFER_HPP_INCLUDED */
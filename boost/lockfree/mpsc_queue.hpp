@@ -0,0 +1,207 @@
+//  intrusive multi-producer/single-consumer queue, based on the algorithm of Dmitry Vyukov,
+//  "Intrusive MPSC node-based queue"
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_MPSC_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_MPSC_QUEUE_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+#include "detail/branch_hints.hpp"
+#include "detail/prefix.hpp"
+
+#include <cstddef>
+
+namespace boost
+{
+namespace lockfree
+{
+
+/** Link hook of the mpsc_queue. Elements of an mpsc_queue have to be derived from mpsc_queue_hook.
+ *
+ *  An element can only be linked into one queue at a time.
+ * */
+class mpsc_queue_hook
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    template <typename T> friend class mpsc_queue;
+
+    detail::atomic<mpsc_queue_hook*> mpsc_next_;
+#endif
+
+public:
+    mpsc_queue_hook(void):
+        mpsc_next_(0)
+    {}
+
+    mpsc_queue_hook(mpsc_queue_hook const &):
+        mpsc_next_(0)
+    {}
+
+    mpsc_queue_hook & operator= (mpsc_queue_hook const &)
+    {
+        return *this;
+    }
+};
+
+/** The mpsc_queue class provides an intrusive multi-producer/single-consumer queue. The queue does not allocate memory
+ *  and does not own its elements, which carry the link in their mpsc_queue_hook base.
+ *
+ *  Producers are wait-free, enqueueing consists of a single atomic exchange on the tail of the queue. The consumer
+ *  only uses loads and stores, unless it has to move the internal stub node.
+ *
+ *  For scheduling the consumer, e.g. the actor owning a mailbox, the consumer can mark an empty queue as idle via
+ *  try_sleep. The first enqueue_notify after that reports the transition to the non-empty state, so exactly one
+ *  producer is responsible for waking up the consumer. A newly constructed queue is not idle.
+ *
+ *  \b Limitation: If a producer is preempted between the exchange and linking its element, the consumer cannot see
+ *  any element, which has been enqueued after it, until the producer resumes. Therefore dequeue may return NULL,
+ *  although the queue is not empty.
+ *
+ * */
+template <typename T>
+class mpsc_queue:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT((boost::is_base_of<mpsc_queue_hook, T>::value));
+
+    typedef mpsc_queue_hook hook;
+
+    detail::atomic<hook*> tail_; /* producers, the lowest bit marks an idle queue */
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(hook*)];
+    hook * head_; /* consumer */
+    hook stub_;
+
+    static const std::size_t idle_bit = 1;
+
+    static hook * mark_idle(hook * h)
+    {
+        return reinterpret_cast<hook*>(reinterpret_cast<std::size_t>(h) | idle_bit);
+    }
+
+    /* returns true, if the queue has been idle */
+    bool link(hook * n)
+    {
+        n->mpsc_next_.store(0, memory_order_relaxed);
+        std::size_t prev = reinterpret_cast<std::size_t>(tail_.exchange(n, memory_order_acq_rel));
+        reinterpret_cast<hook*>(prev & ~idle_bit)->mpsc_next_.store(n, memory_order_release);
+        return prev & idle_bit;
+    }
+#endif
+
+public:
+    //! Constructs an empty queue
+    mpsc_queue(void):
+        tail_(&stub_), head_(&stub_)
+    {}
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return tail_.is_lock_free();
+    }
+
+    /**
+     * \return true, if the queue is empty.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return head_ == &stub_ && stub_.mpsc_next_.load(memory_order_relaxed) == 0;
+    }
+
+    /** Enqueues element t to the queue.
+     *
+     * \pre t is not linked into a queue
+     * \note Thread-safe and wait-free
+     * */
+    void enqueue(T * t)
+    {
+        link(t);
+    }
+
+    /** Enqueues element t to the queue.
+     *
+     * \return true, if the queue has been marked as idle by try_sleep, i.e. if the caller is responsible for waking
+     *         up the consumer.
+     *
+     * \pre t is not linked into a queue
+     * \note Thread-safe and wait-free
+     * */
+    bool enqueue_notify(T * t)
+    {
+        return link(t);
+    }
+
+    /** Marks the queue as idle, if it is empty.
+     *
+     * \return true, if the queue has been marked as idle. In this case the next call to enqueue_notify returns true.
+     *         false, if the queue is not empty, the consumer should continue to dequeue.
+     *
+     * \note Only the consumer may call try_sleep. Non-blocking.
+     * */
+    bool try_sleep(void)
+    {
+        if (head_ != &stub_ || stub_.mpsc_next_.load(memory_order_acquire) != 0)
+            return false;
+
+        hook * expected = &stub_;
+        return tail_.compare_exchange_strong(expected, mark_idle(&stub_), memory_order_acq_rel, memory_order_relaxed)
+            || expected == mark_idle(&stub_);
+    }
+
+    /** Dequeues the oldest element from the queue.
+     *
+     * \return pointer to the element, or NULL, if no element can be dequeued.
+     *
+     * \note Only one thread may dequeue at a time. Non-blocking.
+     * */
+    T * dequeue(void)
+    {
+        hook * head = head_;
+        hook * next = head->mpsc_next_.load(memory_order_acquire);
+
+        if (head == &stub_) {
+            if (next == 0)
+                return 0;
+            head_ = head = next;
+            next = next->mpsc_next_.load(memory_order_acquire);
+        }
+
+        if (next) {
+            head_ = next;
+            return static_cast<T*>(head);
+        }
+
+        if (head != tail_.load(memory_order_acquire))
+            return 0; /* a producer has not linked its element, yet */
+
+        /* head is the last element, requeue the stub to be able to unlink it */
+        link(&stub_);
+
+        next = head->mpsc_next_.load(memory_order_acquire);
+        if (next) {
+            head_ = next;
+            return static_cast<T*>(head);
+        }
+        return 0;
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_MPSC_QUEUE_HPP_INCLUDED */
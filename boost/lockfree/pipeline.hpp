@@ -0,0 +1,337 @@
+//  lock-free multi-stage pipeline over a shared ringbuffer
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_PIPELINE_HPP_INCLUDED
+#define BOOST_LOCKFREE_PIPELINE_HPP_INCLUDED
+
+#include <boost/array.hpp>
+#include <boost/assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/smart_ptr/scoped_array.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+#include "detail/branch_hints.hpp"
+#include "detail/prefix.hpp"
+#include "detail/sequence.hpp"
+
+#include <vector>
+
+namespace boost
+{
+namespace lockfree
+{
+
+namespace detail
+{
+
+struct pipeline_stage:
+    boost::noncopyable
+{
+    padded_sequence sequence; /* cached: minimum of the dependencies */
+    std::vector<std::size_t> dependencies; /* empty: the stage depends on the producer */
+    bool sink; /* no other stage depends on this stage */
+
+    pipeline_stage(void):
+        sink(true)
+    {}
+};
+
+template <typename T>
+class pipeline_internal:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+
+    padded_sequence write_sequence_; /* cached: minimum of the sink sequences */
+    std::vector<pipeline_stage*> stages_;
+    std::vector<size_t> sinks_;
+
+    size_t available_sequence(pipeline_stage const & stage) const
+    {
+        if (stage.dependencies.empty())
+            return write_sequence_.value.load(memory_order_acquire);
+
+        size_t ret = stages_[stage.dependencies[0]]->sequence.value.load(memory_order_acquire);
+        for (size_t i = 1; i != stage.dependencies.size(); ++i) {
+            size_t sequence = stages_[stage.dependencies[i]]->sequence.value.load(memory_order_acquire);
+            if (sequence < ret)
+                ret = sequence;
+        }
+        return ret;
+    }
+
+    size_t gating_sequence(size_t initial) const
+    {
+        size_t ret = initial;
+        for (size_t i = 0; i != sinks_.size(); ++i) {
+            size_t sequence = stages_[sinks_[i]]->sequence.value.load(memory_order_acquire);
+            if (sequence < ret)
+                ret = sequence;
+        }
+        return ret;
+    }
+
+protected:
+    pipeline_internal(void)
+    {}
+
+    ~pipeline_internal(void)
+    {
+        for (size_t i = 0; i != stages_.size(); ++i)
+            delete stages_[i];
+    }
+
+    T * claim(T * buffer, size_t max_size)
+    {
+        BOOST_ASSERT(!stages_.empty());
+        const size_t sequence = write_sequence_.value.load(memory_order_relaxed);
+
+        if (sequence - write_sequence_.cached >= max_size) {
+            write_sequence_.cached = gating_sequence(sequence);
+            if (sequence - write_sequence_.cached >= max_size)
+                return 0; /* the last stages have not released the slot, yet */
+        }
+
+        return buffer + sequence % max_size;
+    }
+
+    void publish(void)
+    {
+        const size_t sequence = write_sequence_.value.load(memory_order_relaxed);
+        write_sequence_.value.store(sequence + 1, memory_order_release);
+    }
+
+    T * front(size_t stage, T * buffer, size_t max_size)
+    {
+        BOOST_ASSERT(stage < stages_.size());
+        pipeline_stage & s = *stages_[stage];
+        const size_t sequence = s.sequence.value.load(memory_order_relaxed);
+
+        if (sequence == s.sequence.cached) {
+            s.sequence.cached = available_sequence(s);
+            if (sequence == s.sequence.cached)
+                return 0;
+        }
+
+        return buffer + sequence % max_size;
+    }
+#endif
+
+public:
+    /** Adds a stage, which processes the elements published by the producer.
+     *
+     * \return index of the stage
+     *
+     * \warning Not thread-safe, all stages have to be added before the pipeline is used
+     * */
+    size_t add_stage(void)
+    {
+        return add_stage(0, 0);
+    }
+
+    /** Adds a stage, which processes the elements after they have been committed by stage dependency.
+     *
+     * \return index of the stage
+     *
+     * \warning Not thread-safe, all stages have to be added before the pipeline is used
+     * */
+    size_t add_stage(size_t dependency)
+    {
+        return add_stage(&dependency, 1);
+    }
+
+    /** Adds a stage, which processes the elements after they have been committed by all count stages in
+     *  dependencies. If count is 0, the stage depends on the producer.
+     *
+     * \return index of the stage
+     *
+     * \warning Not thread-safe, all stages have to be added before the pipeline is used
+     * */
+    size_t add_stage(size_t const * dependencies, size_t count)
+    {
+        const size_t index = stages_.size();
+        pipeline_stage * stage = new pipeline_stage;
+        stage->dependencies.assign(dependencies, dependencies + count);
+        stages_.push_back(stage);
+
+        for (size_t i = 0; i != count; ++i) {
+            BOOST_ASSERT(dependencies[i] < index);
+            stages_[dependencies[i]]->sink = false;
+        }
+
+        sinks_.clear();
+        for (size_t i = 0; i != stages_.size(); ++i)
+            if (stages_[i]->sink)
+                sinks_.push_back(i);
+
+        return index;
+    }
+
+    //! \return number of stages
+    size_t stages(void) const
+    {
+        return stages_.size();
+    }
+
+    /** Releases the element returned by front to the dependent stages or, if stage is a final stage, to the
+     *  producer.
+     *
+     * \pre front has returned a non-NULL pointer for this stage
+     * */
+    void commit(size_t stage)
+    {
+        BOOST_ASSERT(stage < stages_.size());
+        pipeline_stage & s = *stages_[stage];
+        const size_t sequence = s.sequence.value.load(memory_order_relaxed);
+
+        BOOST_ASSERT(sequence != s.sequence.cached);
+        s.sequence.value.store(sequence + 1, memory_order_release);
+    }
+
+    /**
+     * \return true, if the stage has processed all published elements.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(size_t stage)
+    {
+        BOOST_ASSERT(stage < stages_.size());
+        return write_sequence_.value.load(memory_order_relaxed) == stages_[stage]->sequence.value.load(memory_order_relaxed);
+    }
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return write_sequence_.value.is_lock_free();
+    }
+};
+
+} /* namespace detail */
+
+/** The pipeline class provides a single-producer ringbuffer, whose elements are processed in place by a chain or a
+ *  graph of stages. Each stage declares the stages it depends on and only sees an element, after all of them have
+ *  committed it. The producer reuses a slot only after all final stages have committed it.
+ *
+ *  Compared to a chain of ringbuffers, no element is copied between stages and no stage needs an additional
+ *  queue hop. Each stage index must only be used by a single thread.
+ *
+ *  \b Example:
+ *  \code
+ *  pipeline<message, 1024> p;
+ *  size_t decode  = p.add_stage();
+ *  size_t enrich  = p.add_stage(decode);
+ *  size_t publish = p.add_stage(enrich);
+ *  \endcode
+ *
+ * */
+template <typename T, size_t max_size>
+class pipeline:
+    public detail::pipeline_internal<T>
+{
+    typedef std::size_t size_t;
+    typedef detail::pipeline_internal<T> base_type;
+    boost::array<T, max_size> array_;
+
+public:
+    /** Producer side: claims the next slot of the ringbuffer.
+     *
+     * \return pointer to the slot, or NULL, if the final stages have not released the slot, yet. The element is not
+     *         visible to the stages before publish is called.
+     * */
+    T * claim(void)
+    {
+        return base_type::claim(array_.c_array(), max_size);
+    }
+
+    /** Publishes the slot returned by claim to the stages.
+     *
+     * \pre claim has returned a non-NULL pointer
+     * */
+    void publish(void)
+    {
+        base_type::publish();
+    }
+
+    /** Enqueues object t to the pipeline. Enqueueing may fail, if the final stages have not released the oldest
+     *  element.
+     *
+     * \return true, if the enqueue operation is successful.
+     * */
+    bool enqueue(T const & t)
+    {
+        T * slot = claim();
+        if (!slot)
+            return false;
+        *slot = t;
+        publish();
+        return true;
+    }
+
+    /** Accesses the next element of the given stage in place.
+     *
+     * \return pointer to the element, or NULL, if the dependencies of the stage have not committed the element, yet.
+     * */
+    T * front(size_t stage)
+    {
+        return base_type::front(stage, array_.c_array(), max_size);
+    }
+};
+
+template <typename T>
+class pipeline<T, 0>:
+    public detail::pipeline_internal<T>
+{
+    typedef std::size_t size_t;
+    typedef detail::pipeline_internal<T> base_type;
+    size_t max_size_;
+    scoped_array<T> array_;
+
+public:
+    //! Constructs a pipeline with a ringbuffer for max_size elements
+    explicit pipeline(size_t max_size):
+        max_size_(max_size), array_(new T[max_size])
+    {}
+
+    //! \copydoc boost::lockfree::pipeline::claim
+    T * claim(void)
+    {
+        return base_type::claim(array_.get(), max_size_);
+    }
+
+    //! \copydoc boost::lockfree::pipeline::publish
+    void publish(void)
+    {
+        base_type::publish();
+    }
+
+    //! \copydoc boost::lockfree::pipeline::enqueue
+    bool enqueue(T const & t)
+    {
+        T * slot = claim();
+        if (!slot)
+            return false;
+        *slot = t;
+        publish();
+        return true;
+    }
+
+    //! \copydoc boost::lockfree::pipeline::front
+    T * front(size_t stage)
+    {
+        return base_type::front(stage, array_.get(), max_size_);
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_PIPELINE_HPP_INCLUDED */
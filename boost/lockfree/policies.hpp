@@ -0,0 +1,270 @@
+//  policy-based configuration of the containers
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_POLICIES_HPP_INCLUDED
+#define BOOST_LOCKFREE_POLICIES_HPP_INCLUDED
+
+#include <boost/lockfree/detail/branch_hints.hpp>
+
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/count_if.hpp>
+#include <boost/mpl/deref.hpp>
+#include <boost/mpl/eval_if.hpp>
+#include <boost/mpl/find_if.hpp>
+#include <boost/mpl/has_xxx.hpp>
+#include <boost/mpl/identity.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+/* each policy names its category, containers look up one policy per category */
+struct freelist_category {};
+struct capacity_category {};
+struct allocator_category {};
+struct backoff_category {};
+struct node_layout_category {};
+struct no_category {};
+
+/* placeholder for unused policy arguments */
+struct no_policy
+{
+    typedef no_category policy_category;
+};
+
+} /* namespace detail */
+
+/** \name freelist policies
+ *
+ *  struct caching_freelist_t selects a caching freelist, which can allocate more nodes from the operating system,
+ *  struct static_freelist_t a fixed-sized freelist.
+ */
+/* @{ */
+struct caching_freelist_t
+{
+    typedef detail::freelist_category policy_category;
+    typedef caching_freelist_t type;
+};
+
+struct static_freelist_t
+{
+    typedef detail::freelist_category policy_category;
+    typedef static_freelist_t type;
+};
+
+/** freelist policy of containers, which allocate their nodes from a node_pool, which is passed to their constructor
+ *  and can be shared by several containers */
+struct shared_freelist_t
+{
+    typedef detail::freelist_category policy_category;
+    typedef shared_freelist_t type;
+};
+
+/** freelist policy of containers, which allocate their nodes from a fixed-sized indexed_freelist and may refer to
+ *  them by index */
+struct indexed_freelist_t
+{
+    typedef detail::freelist_category policy_category;
+    typedef indexed_freelist_t type;
+};
+
+/** selects static_freelist_t, if IsFixedSized is true, otherwise caching_freelist_t */
+template <bool IsFixedSized>
+struct fixed_sized
+{
+    typedef detail::freelist_category policy_category;
+    typedef typename mpl::if_c<IsFixedSized, static_freelist_t, caching_freelist_t>::type type;
+};
+/* @} */
+
+/** number of nodes, which the default constructor of a container allocates. Unless a freelist policy is given, a
+ *  container with a capacity policy is fixed-sized. */
+template <std::size_t Size>
+struct capacity
+{
+    typedef detail::capacity_category policy_category;
+    static const std::size_t value = Size;
+};
+
+/** allocator of the nodes of a container. For compatibility, an allocator can also be passed without this wrapper. */
+template <typename Alloc>
+struct allocator
+{
+    typedef detail::allocator_category policy_category;
+    typedef Alloc type;
+};
+
+/** \name node layout policies of the fifo */
+/* @{ */
+/** each node is aligned to a cache line, so threads accessing neighboring nodes do not suffer from false sharing */
+struct padded_node_t
+{
+    typedef detail::node_layout_category policy_category;
+    typedef padded_node_t type;
+};
+
+/** nodes occupy only sizeof(tagged_ptr) + sizeof(T) bytes, so several elements share one cache line */
+struct packed_node_t
+{
+    typedef detail::node_layout_category policy_category;
+    typedef packed_node_t type;
+};
+/* @} */
+
+/** \name backoff strategies
+ *
+ *  A backoff strategy is a default-constructible function object, which is called after a compare-and-swap
+ *  operation of a container has failed due to contention. A new object is created for each operation.
+ */
+/* @{ */
+//! retries immediately. this is the default, it compiles to nothing.
+struct no_backoff
+{
+    void operator()(void)
+    {}
+};
+
+//! spins for a number of pause instructions, which doubles after each failure, starting at Min up to Max
+template <std::size_t Min = 1, std::size_t Max = 64>
+class exponential_backoff
+{
+    BOOST_STATIC_ASSERT(Min > 0 && Min <= Max);
+
+    std::size_t spins_;
+
+public:
+    exponential_backoff(void):
+        spins_(Min)
+    {}
+
+    void operator()(void)
+    {
+        for (std::size_t i = 0; i != spins_; ++i)
+            detail::spin_pause();
+
+        if (spins_ < Max)
+            spins_ *= 2;
+    }
+};
+/* @} */
+
+/** backoff strategy, which is used by the compare-and-swap loops of a container */
+template <typename Backoff>
+struct backoff
+{
+    typedef detail::backoff_category policy_category;
+    typedef Backoff type;
+};
+
+namespace detail
+{
+
+BOOST_MPL_HAS_XXX_TRAIT_DEF(policy_category)
+
+/* positional allocator arguments are wrapped into the allocator policy */
+template <typename Policy>
+struct normalize_policy
+{
+    typedef typename mpl::if_<has_policy_category<Policy>,
+                              Policy,
+                              boost::lockfree::allocator<Policy>
+                             >::type type;
+};
+
+template <typename Category>
+struct has_category
+{
+    template <typename Policy>
+    struct apply:
+        boost::is_same<typename Policy::policy_category, Category>
+    {};
+};
+
+/* first policy of a category or Default */
+template <typename Policies, typename Category, typename Default>
+struct get_policy
+{
+private:
+    typedef typename mpl::find_if<Policies, has_category<Category> >::type iter;
+
+public:
+    typedef typename mpl::eval_if<boost::is_same<iter, typename mpl::end<Policies>::type>,
+                                  mpl::identity<Default>,
+                                  mpl::deref<iter>
+                                 >::type type;
+};
+
+/* number of policies of a category */
+template <typename Policies, typename Category>
+struct policy_count:
+    mpl::count_if<Policies, has_category<Category> >
+{};
+
+/** compile-time configuration of a container with value type T, resolved from up to five policy arguments in any
+ *  order. each category may be given at most once. unspecified policies default to a caching freelist, std::allocator, padded nodes and no backoff. */
+template <typename T,
+          typename A0 = no_policy,
+          typename A1 = no_policy,
+          typename A2 = no_policy,
+          typename A3 = no_policy,
+          typename A4 = no_policy
+         >
+struct container_policies
+{
+private:
+    typedef mpl::vector5<typename normalize_policy<A0>::type,
+                         typename normalize_policy<A1>::type,
+                         typename normalize_policy<A2>::type,
+                         typename normalize_policy<A3>::type,
+                         typename normalize_policy<A4>::type
+                        > policies;
+
+    /* a second policy of the same category would be ignored silently, e.g. capacity<16>, capacity<64> */
+    BOOST_STATIC_ASSERT((policy_count<policies, freelist_category>::value <= 1));
+    BOOST_STATIC_ASSERT((policy_count<policies, capacity_category>::value <= 1));
+    BOOST_STATIC_ASSERT((policy_count<policies, allocator_category>::value <= 1));
+    BOOST_STATIC_ASSERT((policy_count<policies, backoff_category>::value <= 1));
+    BOOST_STATIC_ASSERT((policy_count<policies, node_layout_category>::value <= 1));
+
+public:
+    static const std::size_t capacity = get_policy<policies, capacity_category,
+                                                   boost::lockfree::capacity<0> >::type::value;
+    static const bool has_capacity = capacity != 0;
+
+    typedef typename get_policy<policies, freelist_category,
+                                typename mpl::if_c<has_capacity, static_freelist_t, caching_freelist_t>::type
+                               >::type::type freelist_t;
+
+    typedef typename get_policy<policies, allocator_category,
+                                boost::lockfree::allocator<std::allocator<T> >
+                               >::type::type allocator_t;
+
+    typedef typename get_policy<policies, backoff_category,
+                                boost::lockfree::backoff<no_backoff>
+                               >::type::type backoff_t;
+
+    typedef typename get_policy<policies, node_layout_category, padded_node_t>::type::type node_layout_t;
+};
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_POLICIES_HPP_INCLUDED */
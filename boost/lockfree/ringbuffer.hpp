@@ -13,12 +13,14 @@
 
 #ifndef BOOST_LOCKFREE_RINGBUFFER_HPP_INCLUDED
 #define BOOST_LOCKFREE_RINGBUFFER_HPP_INCLUDED
-#include <boost/atomic.hpp>
 #include <boost/array.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/smart_ptr/scoped_array.hpp>
 
+#include <boost/lockfree/detail/atomic.hpp>
+
 #include "detail/branch_hints.hpp"
+#include "detail/bulk_copy.hpp"
 #include "detail/prefix.hpp"
 
 #include <algorithm>
@@ -28,6 +30,12 @@ namespace boost
 namespace lockfree
 {
 
+template <typename Ringbuffer>
+class batched_producer;
+
+template <typename Ringbuffer>
+class batched_consumer;
+
 namespace detail
 {
 
@@ -36,11 +44,14 @@ class ringbuffer_internal:
     boost::noncopyable
 {
 #ifndef BOOST_DOXYGEN_INVOKED
+    template <typename Ringbuffer> friend class lockfree::batched_producer;
+    template <typename Ringbuffer> friend class lockfree::batched_consumer;
+
     typedef std::size_t size_t;
     static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(size_t);
-    atomic<size_t> write_index_;
+    detail::atomic<size_t> write_index_;
     char padding1[padding_size]; /* force read_index and write_index to different cache lines */
-    atomic<size_t> read_index_;
+    detail::atomic<size_t> read_index_;
 
 protected:
     ringbuffer_internal(void):
@@ -112,19 +123,20 @@ protected:
         input_count = std::min(input_count, avail);
 
         size_t new_write_index = write_index + input_count;
+        const bool large_transfer = detail::is_large_transfer<T>(input_count);
 
         if (write_index + input_count > max_size)
         {
             /* copy data in two sections */
             size_t count0 = max_size - write_index;
 
-            std::copy(input_buffer, input_buffer + count0, internal_buffer + write_index);
-            std::copy(input_buffer + count0, input_buffer + input_count, internal_buffer);
+            detail::copy_to_buffer(input_buffer, input_buffer + count0, internal_buffer + write_index, large_transfer);
+            detail::copy_to_buffer(input_buffer + count0, input_buffer + input_count, internal_buffer, large_transfer);
             new_write_index -= max_size;
         }
         else
         {
-            std::copy(input_buffer, input_buffer + input_count, internal_buffer + write_index);
+            detail::copy_to_buffer(input_buffer, input_buffer + input_count, internal_buffer + write_index, large_transfer);
 
             if (new_write_index == max_size)
                 new_write_index = 0;
@@ -147,6 +159,7 @@ protected:
         output_count = std::min(output_count, avail);
 
         size_t new_read_index = read_index + output_count;
+        const bool large_transfer = detail::is_large_transfer<T>(output_count);
 
         if (read_index + output_count > max_size)
         {
@@ -154,14 +167,15 @@ protected:
             size_t count0 = max_size - read_index;
             size_t count1 = output_count - count0;
 
-            std::copy(internal_buffer + read_index, internal_buffer + max_size, output_buffer);
-            std::copy(internal_buffer, internal_buffer + count1, output_buffer + count0);
+            detail::copy_from_buffer(internal_buffer + read_index, internal_buffer + max_size, output_buffer, large_transfer);
+            detail::copy_from_buffer(internal_buffer, internal_buffer + count1, output_buffer + count0, large_transfer);
 
             new_read_index -= max_size;
         }
         else
         {
-            std::copy(internal_buffer + read_index, internal_buffer + read_index + output_count, output_buffer);
+            detail::copy_from_buffer(internal_buffer + read_index, internal_buffer + read_index + output_count, output_buffer,
+                                     large_transfer);
             if (new_read_index == max_size)
                 new_read_index = 0;
         }
@@ -169,6 +183,40 @@ protected:
         read_index_.store(new_read_index, memory_order_release);
         return output_count;
     }
+
+    /* two-phase interface for storage backends, which can expose the free/used part of the buffer as one
+     * contiguous window: the window starts at the returned index, its size is written to available */
+    size_t prepare_write(size_t & available, size_t max_size) const
+    {
+        const size_t write_index = write_index_.load(memory_order_relaxed);
+        const size_t read_index  = read_index_.load(memory_order_acquire);
+        available = write_available(write_index, read_index, max_size);
+        return write_index;
+    }
+
+    void commit_write(size_t count, size_t max_size)
+    {
+        size_t write_index = write_index_.load(memory_order_relaxed) + count;
+        if (write_index >= max_size)
+            write_index -= max_size;
+        write_index_.store(write_index, memory_order_release);
+    }
+
+    size_t prepare_read(size_t & available, size_t max_size) const
+    {
+        const size_t write_index = write_index_.load(memory_order_acquire);
+        const size_t read_index  = read_index_.load(memory_order_relaxed);
+        available = read_available(write_index, read_index, max_size);
+        return read_index;
+    }
+
+    void commit_read(size_t count, size_t max_size)
+    {
+        size_t read_index = read_index_.load(memory_order_relaxed) + count;
+        if (read_index >= max_size)
+            read_index -= max_size;
+        read_index_.store(read_index, memory_order_release);
+    }
 #endif
 
 
@@ -215,7 +263,24 @@ class ringbuffer:
     typedef std::size_t size_t;
     boost::array<T, max_size> array_;
 
+#ifndef BOOST_DOXYGEN_INVOKED
+    template <typename Ringbuffer> friend class batched_producer;
+    template <typename Ringbuffer> friend class batched_consumer;
+
+    T * buffer(void)
+    {
+        return array_.c_array();
+    }
+
+    size_t capacity(void) const
+    {
+        return max_size;
+    }
+#endif
+
 public:
+    typedef T value_type;
+
     /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
      *
      * \return true, if the enqueue operation is successful.
@@ -272,7 +337,24 @@ class ringbuffer<T, 0>:
     size_t max_size_;
     scoped_array<T> array_;
 
+#ifndef BOOST_DOXYGEN_INVOKED
+    template <typename Ringbuffer> friend class batched_producer;
+    template <typename Ringbuffer> friend class batched_consumer;
+
+    T * buffer(void)
+    {
+        return array_.get();
+    }
+
+    size_t capacity(void) const
+    {
+        return max_size_;
+    }
+#endif
+
 public:
+    typedef T value_type;
+
     //! Constructs a ringbuffer for max_size elements
     explicit ringbuffer(size_t max_size):
         max_size_(max_size), array_(new T[max_size])
@@ -326,6 +408,158 @@ public:
     }
 };
 
+/** Producer side handle of a ringbuffer, which publishes the write index in batches.
+ *
+ *  Elements are written to the ringbuffer immediately, but they only become visible to the consumer every batch_size
+ *  elements, when flush() is called, when the ringbuffer is full or when the handle is destroyed. This reduces the
+ *  cache coherence traffic on the write index at high message rates. The read index of the consumer is only reloaded,
+ *  if the ringbuffer appears to be full.
+ *
+ *  \warning While a batched_producer exists, it is the only producer of the ringbuffer. Its enqueue operations must
+ *  not be mixed with the enqueue operations of the ringbuffer itself.
+ * */
+template <typename Ringbuffer>
+class batched_producer:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef typename Ringbuffer::value_type T;
+    typedef detail::ringbuffer_internal<T> internal;
+
+    Ringbuffer & rb_;
+    const size_t batch_size_;
+    size_t write_index_;
+    size_t read_index_;
+    size_t pending_;
+#endif
+
+public:
+    //! Constructs a producer handle, which publishes the write index every batch_size elements
+    batched_producer(Ringbuffer & rb, size_t batch_size):
+        rb_(rb), batch_size_(batch_size),
+        write_index_(rb.write_index_.load(memory_order_relaxed)),
+        read_index_(rb.read_index_.load(memory_order_acquire)),
+        pending_(0)
+    {}
+
+    //! Publishes all pending elements
+    ~batched_producer(void)
+    {
+        flush();
+    }
+
+    /** Writes object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note The element is visible to the consumer after the next flush
+     * */
+    bool enqueue(T const & t)
+    {
+        const size_t max_size = rb_.capacity();
+        const size_t next = internal::next_index(write_index_, max_size);
+
+        if (unlikely(next == read_index_)) {
+            read_index_ = rb_.read_index_.load(memory_order_acquire);
+            if (next == read_index_) {
+                flush(); /* ringbuffer is full */
+                return false;
+            }
+        }
+
+        rb_.buffer()[write_index_] = t;
+        write_index_ = next;
+
+        if (++pending_ >= batch_size_)
+            flush();
+        return true;
+    }
+
+    //! Publishes all pending elements to the consumer
+    void flush(void)
+    {
+        if (pending_) {
+            rb_.write_index_.store(write_index_, memory_order_release);
+            pending_ = 0;
+        }
+    }
+};
+
+/** Consumer side handle of a ringbuffer, which publishes the read index in batches.
+ *
+ *  Slots of dequeued elements are handed back to the producer every batch_size elements, when flush() is called, when
+ *  the ringbuffer appears to be empty or when the handle is destroyed. The write index of the producer is only
+ *  reloaded, if the ringbuffer appears to be empty.
+ *
+ *  \warning While a batched_consumer exists, it is the only consumer of the ringbuffer. Its dequeue operations must
+ *  not be mixed with the dequeue operations of the ringbuffer itself.
+ * */
+template <typename Ringbuffer>
+class batched_consumer:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef std::size_t size_t;
+    typedef typename Ringbuffer::value_type T;
+    typedef detail::ringbuffer_internal<T> internal;
+
+    Ringbuffer & rb_;
+    const size_t batch_size_;
+    size_t read_index_;
+    size_t write_index_;
+    size_t pending_;
+#endif
+
+public:
+    //! Constructs a consumer handle, which publishes the read index every batch_size elements
+    batched_consumer(Ringbuffer & rb, size_t batch_size):
+        rb_(rb), batch_size_(batch_size),
+        read_index_(rb.read_index_.load(memory_order_relaxed)),
+        write_index_(rb.write_index_.load(memory_order_acquire)),
+        pending_(0)
+    {}
+
+    //! Releases the slots of all dequeued elements
+    ~batched_consumer(void)
+    {
+        flush();
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     */
+    bool dequeue(T * ret)
+    {
+        if (unlikely(read_index_ == write_index_)) {
+            write_index_ = rb_.write_index_.load(memory_order_acquire);
+            if (read_index_ == write_index_) {
+                flush(); /* ringbuffer is empty */
+                return false;
+            }
+        }
+
+        *ret = rb_.buffer()[read_index_];
+        read_index_ = internal::next_index(read_index_, rb_.capacity());
+
+        if (++pending_ >= batch_size_)
+            flush();
+        return true;
+    }
+
+    //! Hands the slots of all dequeued elements back to the producer
+    void flush(void)
+    {
+        if (pending_) {
+            rb_.read_index_.store(read_index_, memory_order_release);
+            pending_ = 0;
+        }
+    }
+};
 
 } /* namespace lockfree */
 } /* namespace boost */
@@ -0,0 +1,344 @@
+//  lock-free single-producer/single-consumer ringbuffer in posix shared memory
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_SHM_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_SHM_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/ringbuffer.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/type_traits/is_pod.hpp>
+
+#include <cerrno>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace boost
+{
+namespace lockfree
+{
+
+namespace detail
+{
+
+/* the control block is placed inside the shared memory segment, so both processes use the same index words */
+template <typename T>
+struct shm_ringbuffer_control:
+    ringbuffer_internal<T>
+{
+    using ringbuffer_internal<T>::enqueue;
+    using ringbuffer_internal<T>::dequeue;
+};
+
+/* segment layout: header | control block | element storage, each starting at a cache line boundary.
+ * all addressing is done relative to the segment base, since it is mapped at different addresses
+ * in different processes. */
+struct shm_ringbuffer_header
+{
+    detail::atomic<boost::uint32_t> magic;
+    boost::uint32_t version;
+    boost::uint64_t element_size;
+    boost::uint64_t max_size;
+    boost::uint64_t control_offset;
+    boost::uint64_t data_offset;
+};
+
+inline std::size_t shm_align(std::size_t offset)
+{
+    return (offset + BOOST_LOCKFREE_CACHELINE_BYTES - 1) & ~std::size_t(BOOST_LOCKFREE_CACHELINE_BYTES - 1);
+}
+
+inline void shm_throw_last_error(const char * what)
+{
+    throw boost::system::system_error(errno, boost::system::system_category(), what);
+}
+
+} /* namespace detail */
+
+/** The shm_ringbuffer class provides a single-writer/single-reader ringbuffer, which is placed in a named posix
+ *  shared memory segment, so that producer and consumer can live in different processes.
+ *
+ *  One process creates the segment, the other process attaches to it by name. Enqueueing and dequeueing do not
+ *  involve any system calls.
+ *
+ *  \b Limitation: The shm_ringbuffer class is limited to PODs, which do not contain pointers into the address space
+ *  of one process.
+ *
+ * */
+template <typename T>
+class shm_ringbuffer:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+
+    typedef std::size_t size_t;
+    typedef detail::shm_ringbuffer_control<T> control_t;
+
+    static const boost::uint32_t layout_magic = 0x6c667262; /* "lfrb" */
+    static const boost::uint32_t layout_version = 1;
+
+    char * segment_;
+    size_t segment_size_;
+    size_t max_size_;
+    control_t * control_;
+    T * buffer_;
+    std::string name_; /* copied, the destructor of the owner unlinks it */
+    bool owner_;
+
+    detail::shm_ringbuffer_header * header(void) const
+    {
+        return reinterpret_cast<detail::shm_ringbuffer_header*>(segment_);
+    }
+
+    void map_segment(int fd, size_t size)
+    {
+        void * segment = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (segment == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            detail::shm_throw_last_error("shm_ringbuffer: mmap");
+        }
+        ::close(fd);
+
+        segment_ = static_cast<char*>(segment);
+        segment_size_ = size;
+    }
+
+    void unmap_segment(void)
+    {
+        ::munmap(segment_, segment_size_);
+    }
+
+    /* the header of an attached segment is not trusted: control block and element storage have to lie inside the
+     * segment, in this order and at cache line boundaries */
+    static bool layout_valid(detail::shm_ringbuffer_header const & h, size_t segment_size)
+    {
+        const boost::uint64_t alignment_mask = BOOST_LOCKFREE_CACHELINE_BYTES - 1;
+
+        if (h.version != layout_version || h.element_size != sizeof(T) || h.max_size == 0)
+            return false;
+
+        if ((h.control_offset & alignment_mask) || (h.data_offset & alignment_mask))
+            return false;
+
+        if (h.control_offset < sizeof(detail::shm_ringbuffer_header) ||
+            h.control_offset > h.data_offset ||
+            h.data_offset - h.control_offset < sizeof(control_t) ||
+            h.data_offset > segment_size)
+            return false;
+
+        /* data_offset + max_size * sizeof(T) <= segment_size, without overflowing the product */
+        return h.max_size <= (segment_size - h.data_offset) / sizeof(T);
+    }
+
+    void attach_layout(void)
+    {
+        control_ = reinterpret_cast<control_t*>(segment_ + header()->control_offset);
+        buffer_ = reinterpret_cast<T*>(segment_ + header()->data_offset);
+        max_size_ = header()->max_size;
+    }
+#endif
+
+public:
+    /** Creates the shared memory segment name and constructs a ringbuffer for max_size elements inside it.
+     *
+     * \throws boost::system::system_error, if max_size is zero, or if the segment already exists or cannot be created
+     *
+     * \note The segment is removed, when the creating shm_ringbuffer is destroyed. Processes, which are attached
+     *       at that time, can continue to use it.
+     * */
+    shm_ringbuffer(const char * name, size_t max_size):
+        name_(name), owner_(true)
+    {
+        if (max_size == 0)
+            throw boost::system::system_error(boost::system::errc::make_error_code(boost::system::errc::invalid_argument),
+                                              "shm_ringbuffer: max_size must not be zero");
+
+        const size_t control_offset = detail::shm_align(sizeof(detail::shm_ringbuffer_header));
+        const size_t data_offset = detail::shm_align(control_offset + sizeof(control_t));
+        const size_t size = data_offset + max_size * sizeof(T);
+
+        int fd = ::shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd == -1)
+            detail::shm_throw_last_error("shm_ringbuffer: shm_open");
+
+        if (::ftruncate(fd, size) == -1) {
+            int error = errno;
+            ::close(fd);
+            ::shm_unlink(name);
+            errno = error;
+            detail::shm_throw_last_error("shm_ringbuffer: ftruncate");
+        }
+
+        try {
+            map_segment(fd, size);
+        } catch (...) {
+            ::shm_unlink(name);
+            throw;
+        }
+
+        detail::shm_ringbuffer_header * h = new(segment_) detail::shm_ringbuffer_header;
+        h->version = layout_version;
+        h->element_size = sizeof(T);
+        h->max_size = max_size;
+        h->control_offset = control_offset;
+        h->data_offset = data_offset;
+        new(segment_ + control_offset) control_t();
+
+        attach_layout();
+
+        if (!control_->is_lock_free()) {
+            unmap_segment();
+            ::shm_unlink(name);
+            throw boost::system::system_error(boost::system::errc::make_error_code(boost::system::errc::not_supported),
+                                              "shm_ringbuffer: atomic indices are not lock-free");
+        }
+
+        /* publish the layout, the attaching process checks the magic number with acquire semantics */
+        h->magic.store(layout_magic, memory_order_release);
+    }
+
+    /** Attaches to the ringbuffer in the existing shared memory segment name.
+     *
+     * \throws boost::system::system_error, if the segment does not exist, it has not been completely initialized yet,
+     *         or its layout does not match (different library version or element type, truncated or foreign segment)
+     * */
+    explicit shm_ringbuffer(const char * name):
+        name_(name), owner_(false)
+    {
+        int fd = ::shm_open(name, O_RDWR, 0600);
+        if (fd == -1)
+            detail::shm_throw_last_error("shm_ringbuffer: shm_open");
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+            int error = errno;
+            ::close(fd);
+            errno = error;
+            detail::shm_throw_last_error("shm_ringbuffer: fstat");
+        }
+
+        if (size_t(st.st_size) < sizeof(detail::shm_ringbuffer_header)) {
+            ::close(fd);
+            throw boost::system::system_error(boost::system::errc::make_error_code(boost::system::errc::invalid_argument),
+                                              "shm_ringbuffer: segment too small");
+        }
+
+        map_segment(fd, st.st_size);
+
+        detail::shm_ringbuffer_header * h = header();
+        if (h->magic.load(memory_order_acquire) != layout_magic || !layout_valid(*h, segment_size_)) {
+            unmap_segment();
+            throw boost::system::system_error(boost::system::errc::make_error_code(boost::system::errc::invalid_argument),
+                                              "shm_ringbuffer: layout mismatch");
+        }
+
+        attach_layout();
+    }
+
+    /** Unmaps the shared memory segment. If the ringbuffer has been created by this object, the segment name is removed.
+     *
+     *  \warning not threadsafe
+     * */
+    ~shm_ringbuffer(void)
+    {
+        unmap_segment();
+        if (owner_)
+            ::shm_unlink(name_.c_str());
+    }
+
+    /** Removes the shared memory segment name, e.g. a stale segment of a crashed process.
+     *
+     * \return true, if the segment has been removed.
+     * */
+    static bool remove(const char * name)
+    {
+        return ::shm_unlink(name) == 0;
+    }
+
+    /** Enqueues object t to the ringbuffer. Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * */
+    bool enqueue(T const & t)
+    {
+        return control_->enqueue(t, buffer_, max_size_);
+    }
+
+    /** Dequeue object from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if ringbuffer was empty.
+     *
+     */
+    bool dequeue(T * ret)
+    {
+        return control_->dequeue(ret, buffer_, max_size_);
+    }
+
+    /** Enqueues size objects from the array t to the ringbuffer.
+     *
+     *  Enqueueing may fail, if the ringbuffer is full.
+     *
+     * \return number of enqueued items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    size_t enqueue(T const * t, size_t size)
+    {
+        return control_->enqueue(t, size, buffer_, max_size_);
+    }
+
+    /** Dequeue a maximum of size objects from ringbuffer.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return number of dequeued items
+     *
+     * */
+    size_t dequeue(T * ret, size_t size)
+    {
+        return control_->dequeue(ret, size, buffer_, max_size_);
+    }
+
+    /**
+     * \return true, if ringbuffer is empty.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        return control_->empty();
+    }
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return control_->is_lock_free();
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_SHM_RINGBUFFER_HPP_INCLUDED */
@@ -9,14 +9,18 @@
 #ifndef BOOST_LOCKFREE_STACK_HPP_INCLUDED
 #define BOOST_LOCKFREE_STACK_HPP_INCLUDED
 
-#include <boost/atomic.hpp>
 #include <boost/checked_delete.hpp>
 
+#include <boost/mpl/if.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/is_same.hpp>
 
+#include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 #include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/policies.hpp>
 #include <boost/noncopyable.hpp>
 
 
@@ -26,26 +30,20 @@ namespace boost
 namespace lockfree
 {
 
-/** It uses a freelist for memory management, freed nodes are pushed to the freelist, but not returned to the os.
- *  This may result in leaking memory.
- *
- *  The memory management of the stack can be controlled via its freelist_t template argument. Two different
- *  freelists can be used. struct caching_freelist_t selects a caching freelist, which can allocate more nodes
- *  from the operating system, and struct static_freelist_t uses a fixed-sized freelist. With a fixed-sized
- *  freelist, the push operation may fail, while with a caching freelist, the push operation may block.
- *
- *  \b Limitation: The stack class is limited to PODs
- *
- * */
-template <typename T,
-          typename freelist_t = caching_freelist_t,
-          typename Alloc = std::allocator<T>
-          >
+namespace detail
+{
+
+template <typename T, typename Policies>
 class stack:
     boost::noncopyable
 {
 private:
 #ifndef BOOST_DOXYGEN_INVOKED
+    typedef Policies policies;
+    typedef typename policies::freelist_t freelist_t;
+    typedef typename policies::allocator_t Alloc;
+    typedef typename policies::backoff_t backoff_t;
+
     struct node
     {
         typedef tagged_ptr<node> tagged_ptr_t;
@@ -62,23 +60,26 @@ private:
     typedef tagged_ptr<node> tagged_ptr_t;
 
     typedef typename Alloc::template rebind<node>::other node_allocator;
-/*     typedef typename detail::select_freelist<node, node_allocator, freelist_t>::type pool_t; */
-
-    typedef typename boost::mpl::if_<boost::is_same<freelist_t, caching_freelist_t>,
-                                     caching_freelist<node, node_allocator>,
-                                     static_freelist<node, node_allocator>
-                                     >::type pool_t;
+    typedef typename detail::select_freelist<node, node_allocator, freelist_t,
+                                             typename detail::shared_pool<T>::type>::type pool_t;
 
 public:
-    //! \copydoc boost::lockfree::fifo::is_lock_free
+#ifdef BOOST_DOXYGEN_INVOKED
+    //! node_pool, which can be shared by stacks, fifos and deques with the shared_freelist_t policy and the same value size
+    typedef implementation_defined pool_type;
+#else
+    typedef typename detail::shared_pool<T>::type pool_type;
+#endif
+
+    //! \copydoc boost::lockfree::detail::fifo::is_lock_free
     const bool is_lock_free (void) const
     {
         return tos.is_lock_free();
     }
 
-    //! Construct stack with 128 of initially allocated stack nodes.
+    //! Construct stack with 128 of initially allocated stack nodes, or capacity nodes, if the capacity policy is given
     stack(void):
-        tos(tagged_ptr_t(NULL, 0)), pool(128)
+        tos(tagged_ptr_t(NULL, 0)), pool(policies::has_capacity ? policies::capacity : 128)
     {}
 
     //! Construct stack with a number of initially allocated stack nodes.
@@ -86,6 +87,14 @@ public:
         tos(tagged_ptr_t(NULL, 0)), pool(n)
     {}
 
+    /** Construct stack, which allocates its nodes from a shared node pool.
+     *
+     * \pre the freelist policy is shared_freelist_t, the pool outlives the stack
+     * */
+    explicit stack(pool_type & shared_pool):
+        tos(tagged_ptr_t(NULL, 0)), pool(shared_pool)
+    {}
+
     /** Destroys stack, free all nodes from freelist.
      *
      *  \warning not threadsafe
@@ -93,15 +102,9 @@ public:
      * */
     ~stack(void)
     {
-        if (!empty())
-        {
-            T dummy;
-            for(;;)
-            {
-                if (!pop(&dummy))
-                    break;
-            }
-        }
+        T dummy;
+        while (unsynchronized_pop(&dummy))
+            ;
     }
 
     /** Pushes object t to the fifo. May fail, if the freelist is not able to allocate a new fifo node.
@@ -118,14 +121,19 @@ public:
         if (newnode == 0)
             return false;
 
+        /* the release cas publishes the value and the next pointer of newnode to the acquire load in pop. if
+         * the cas fails, it updates old_tos, which is only stored, but not dereferenced, so the load and the
+         * failure ordering can be relaxed */
+        tagged_ptr_t old_tos = tos.load(memory_order_relaxed);
+        backoff_t backoff;
         for (;;)
         {
-            tagged_ptr_t old_tos = tos.load(memory_order_relaxed);
             tagged_ptr_t new_tos (newnode, old_tos.get_tag());
             newnode->next.set_ptr(old_tos.get_ptr());
 
-            if (tos.compare_exchange_strong(old_tos, new_tos))
+            if (tos.compare_exchange_weak(old_tos, new_tos, memory_order_release, memory_order_relaxed))
                 return true;
+            backoff();
         }
     }
 
@@ -140,24 +148,109 @@ public:
      * */
     bool pop(T * ret)
     {
+        /* old_tos is dereferenced after the initial load and after a failed cas, so both synchronize with the
+         * release cas of push. the success ordering cannot be weaker than the failure ordering */
+        tagged_ptr_t old_tos = tos.load(memory_order_acquire);
+        backoff_t backoff;
         for (;;)
         {
-            tagged_ptr_t old_tos = tos.load(memory_order_consume);
-
             if (!old_tos.get_ptr())
                 return false;
 
             node * new_tos_ptr = old_tos->next.get_ptr();
             tagged_ptr_t new_tos(new_tos_ptr, old_tos.get_tag() + 1);
 
-            if (tos.compare_exchange_strong(old_tos, new_tos))
+            if (tos.compare_exchange_weak(old_tos, new_tos, memory_order_acquire, memory_order_acquire))
             {
                 *ret = old_tos->v;
                 dealloc_node(old_tos.get_ptr());
                 return true;
             }
+            backoff();
+        }
+    }
+
+    /** \name unsynchronized operations
+     *
+     *  Variants of push and pop, which use plain loads and stores instead of compare-and-swap loops, e.g. to fill the
+     *  stack before the consumer threads are started or to drain it after they have been joined.
+     *
+     *  \warning Not thread-safe. The caller guarantees, that no other thread accesses the stack or its freelist, and
+     *           synchronizes with the threads, which access them later, e.g. by starting them afterwards.
+     * */
+    /* @{ */
+    bool unsynchronized_push(T const & v)
+    {
+        node * newnode = alloc_node_unsynchronized(v);
+
+        if (newnode == 0)
+            return false;
+
+        link_unsynchronized(newnode, newnode);
+        return true;
+    }
+
+    /** Pushes the objects of the range [begin, end), so that the last object is on top of the stack. The nodes are
+     *  chained first and then linked to the stack at once.
+     *
+     * \returns iterator to the first object, which has not been pushed, because the freelist is not able to allocate a
+     *          new stack node, or end.
+     * */
+    template <typename ConstIterator>
+    ConstIterator unsynchronized_push(ConstIterator begin, ConstIterator end)
+    {
+        if (begin == end)
+            return begin;
+
+        node * bottom = alloc_node_unsynchronized(*begin);
+        if (bottom == 0)
+            return begin;
+
+        node * top = bottom;
+        for (++begin; begin != end; ++begin)
+        {
+            node * newnode = alloc_node_unsynchronized(*begin);
+            if (newnode == 0)
+                break;
+
+            newnode->next.set_ptr(top);
+            top = newnode;
+        }
+
+        link_unsynchronized(top, bottom);
+        return begin;
+    }
+
+    bool unsynchronized_pop(T * ret)
+    {
+        tagged_ptr_t old_tos = tos.load(memory_order_relaxed);
+
+        if (!old_tos.get_ptr())
+            return false;
+
+        tos.store(tagged_ptr_t(old_tos->next.get_ptr(), old_tos.get_tag() + 1), memory_order_relaxed);
+        *ret = old_tos->v;
+        dealloc_node_unsynchronized(old_tos.get_ptr());
+        return true;
+    }
+
+    /** Pops all objects of the stack to the output iterator out, starting at the top.
+     *
+     * \returns number of popped objects
+     * */
+    template <typename OutputIterator>
+    std::size_t unsynchronized_pop_all(OutputIterator out)
+    {
+        std::size_t count = 0;
+        T element;
+        while (unsynchronized_pop(&element))
+        {
+            *out++ = element;
+            ++count;
         }
+        return count;
     }
+    /* @} */
 
     /**
      * \return true, if stack is empty.
@@ -174,6 +267,8 @@ private:
     node * alloc_node(T const & t)
     {
         node * chunk = pool.allocate();
+        if (chunk == 0)
+            return 0;
         new(chunk) node(t);
         return chunk;
     }
@@ -184,7 +279,30 @@ private:
         pool.deallocate(n);
     }
 
-    atomic<tagged_ptr_t> tos;
+    node * alloc_node_unsynchronized(T const & t)
+    {
+        node * chunk = pool.unsynchronized_allocate();
+        if (chunk == 0)
+            return 0;
+        new(chunk) node(t);
+        return chunk;
+    }
+
+    void dealloc_node_unsynchronized(node * n)
+    {
+        n->~node();
+        pool.unsynchronized_deallocate(n);
+    }
+
+    /* links the chain of nodes from top to bottom on top of the stack */
+    void link_unsynchronized(node * top, node * bottom)
+    {
+        tagged_ptr_t old_tos = tos.load(memory_order_relaxed);
+        bottom->next.set_ptr(old_tos.get_ptr());
+        tos.store(tagged_ptr_t(top, old_tos.get_tag()), memory_order_relaxed);
+    }
+
+    detail::atomic<tagged_ptr_t> tos;
 
     static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(tagged_ptr_t);
     char padding[padding_size];
@@ -193,6 +311,252 @@ private:
 #endif
 };
 
+/** stack with a compile-time capacity, whose nodes are stored inside the stack object and linked by 16bit or 32bit
+ *  indices. The top of stack is a tagged index in a 64bit word. No memory is allocated from the heap.
+ * */
+template <typename T, std::size_t max_size, typename Backoff>
+class fixed_stack:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+
+    typedef typename select_tagged_index<max_size>::type tagged_index_t;
+    typedef typename tagged_index_t::index_t index_t;
+
+    struct node
+    {
+        node(T const & v):
+            v(v)
+        {}
+
+        index_t next;
+        T v;
+    };
+
+    typedef fixed_freelist<node, max_size> pool_t;
+#endif
+
+public:
+    //! containers with inline storage cannot share a node pool
+    struct pool_type;
+
+    //! \copydoc boost::lockfree::detail::stack::is_lock_free
+    bool is_lock_free (void) const
+    {
+        return tos.is_lock_free();
+    }
+
+    //! Construct stack. No memory is allocated.
+    fixed_stack(void):
+        tos(tagged_index_t(0, 0))
+    {}
+
+    //! \copydoc boost::lockfree::detail::stack::push
+    bool push(T const & v)
+    {
+        node * newnode = pool.allocate();
+
+        if (newnode == 0)
+            return false;
+
+        new(newnode) node(v);
+        index_t index = pool.get_index(newnode);
+
+        /* memory ordering: see stack */
+        tagged_index_t old_tos = tos.load(memory_order_relaxed);
+        Backoff backoff;
+        for (;;)
+        {
+            tagged_index_t new_tos (index, old_tos.get_tag());
+            newnode->next = old_tos.get_index();
+
+            if (tos.compare_exchange_weak(old_tos, new_tos, memory_order_release, memory_order_relaxed))
+                return true;
+            backoff();
+        }
+    }
+
+    //! \copydoc boost::lockfree::detail::stack::pop
+    bool pop(T * ret)
+    {
+        tagged_index_t old_tos = tos.load(memory_order_acquire);
+        Backoff backoff;
+        for (;;)
+        {
+            node * old_tos_node = pool.pointer(old_tos.get_index());
+            if (!old_tos_node)
+                return false;
+
+            tagged_index_t new_tos(old_tos_node->next, old_tos.get_tag() + 1);
+
+            if (tos.compare_exchange_weak(old_tos, new_tos, memory_order_acquire, memory_order_acquire))
+            {
+                *ret = old_tos_node->v;
+                pool.deallocate(old_tos_node);
+                return true;
+            }
+            backoff();
+        }
+    }
+
+    //! \copydoc boost::lockfree::detail::stack::unsynchronized_push(T const &)
+    bool unsynchronized_push(T const & v)
+    {
+        node * newnode = pool.unsynchronized_allocate();
+
+        if (newnode == 0)
+            return false;
+
+        new(newnode) node(v);
+        link_unsynchronized(newnode, newnode);
+        return true;
+    }
+
+    //! \copydoc boost::lockfree::detail::stack::unsynchronized_push(ConstIterator, ConstIterator)
+    template <typename ConstIterator>
+    ConstIterator unsynchronized_push(ConstIterator begin, ConstIterator end)
+    {
+        if (begin == end)
+            return begin;
+
+        node * bottom = pool.unsynchronized_allocate();
+        if (bottom == 0)
+            return begin;
+
+        new(bottom) node(*begin);
+        node * top = bottom;
+        for (++begin; begin != end; ++begin)
+        {
+            node * newnode = pool.unsynchronized_allocate();
+            if (newnode == 0)
+                break;
+
+            new(newnode) node(*begin);
+            newnode->next = pool.get_index(top);
+            top = newnode;
+        }
+
+        link_unsynchronized(top, bottom);
+        return begin;
+    }
+
+    //! \copydoc boost::lockfree::detail::stack::unsynchronized_pop
+    bool unsynchronized_pop(T * ret)
+    {
+        tagged_index_t old_tos = tos.load(memory_order_relaxed);
+        node * old_tos_node = pool.pointer(old_tos.get_index());
+
+        if (!old_tos_node)
+            return false;
+
+        tos.store(tagged_index_t(old_tos_node->next, old_tos.get_tag() + 1), memory_order_relaxed);
+        *ret = old_tos_node->v;
+        pool.unsynchronized_deallocate(old_tos_node);
+        return true;
+    }
+
+    //! \copydoc boost::lockfree::detail::stack::unsynchronized_pop_all
+    template <typename OutputIterator>
+    std::size_t unsynchronized_pop_all(OutputIterator out)
+    {
+        std::size_t count = 0;
+        T element;
+        while (unsynchronized_pop(&element))
+        {
+            *out++ = element;
+            ++count;
+        }
+        return count;
+    }
+
+    //! \copydoc boost::lockfree::detail::stack::empty
+    bool empty(void) const
+    {
+        return tos.load().get_index() == 0;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    void link_unsynchronized(node * top, node * bottom)
+    {
+        tagged_index_t old_tos = tos.load(memory_order_relaxed);
+        bottom->next = old_tos.get_index();
+        tos.store(tagged_index_t(pool.get_index(top), old_tos.get_tag()), memory_order_relaxed);
+    }
+
+    detail::atomic<tagged_index_t> tos;
+
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(tagged_index_t);
+    char padding[padding_size];
+
+    pool_t pool;
+#endif
+};
+
+/* stacks with a capacity policy and a fixed-sized freelist use inline storage */
+template <typename T, typename Policies>
+struct select_stack
+{
+    static const bool inline_storage = Policies::has_capacity &&
+                                       boost::is_same<typename Policies::freelist_t, static_freelist_t>::value;
+
+    typedef typename mpl::if_c<inline_storage,
+                               fixed_stack<T, Policies::capacity, typename Policies::backoff_t>,
+                               stack<T, Policies>
+                              >::type type;
+};
+
+} /* namespace detail */
+
+/** It uses a freelist for memory management, freed nodes are pushed to the freelist, but not returned to the os.
+ *  This may result in leaking memory.
+ *
+ *  The memory management of the stack can be controlled via a freelist policy. struct caching_freelist_t selects a
+ *  caching freelist, which can allocate more nodes from the operating system, and struct static_freelist_t uses a
+ *  fixed-sized freelist. With a fixed-sized freelist, the push operation may fail, while with a caching freelist, the
+ *  push operation may block. struct shared_freelist_t allocates the nodes from a node_pool of type pool_type, which is
+ *  passed to the constructor and can be shared with stacks, fifos and deques, whose value type has the same size and
+ *  alignment.
+ *
+ *  The capacity, fixed_sized, allocator and backoff policies are applied like for the fifo class. A fixed-sized stack
+ *  with a capacity policy stores its nodes inside the stack object and does not allocate memory from the heap. The
+ *  positional form stack<T, freelist_t, Alloc> is still accepted.
+ *
+ *  During phases, in which a single thread accesses the stack, e.g. while it is filled at startup or drained at
+ *  shutdown, unsynchronized_push and unsynchronized_pop avoid the compare-and-swap operations.
+ *
+ *  \b Limitation: The stack class is limited to PODs
+ *
+ * */
+template <typename T,
+          typename A0 = detail::no_policy,
+          typename A1 = detail::no_policy,
+          typename A2 = detail::no_policy,
+          typename A3 = detail::no_policy
+          >
+class stack:
+    public detail::select_stack<T, detail::container_policies<T, A0, A1, A2, A3> >::type
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::select_stack<T, detail::container_policies<T, A0, A1, A2, A3> >::type stack_t;
+#endif
+
+public:
+    //! \copydoc detail::stack::stack(void)
+    stack(void)
+    {}
+
+    //! Construct stack with a number of initially allocated stack nodes.
+    explicit stack(std::size_t n):
+        stack_t(n)
+    {}
+
+    //! \copydoc detail::stack::stack(pool_type&)
+    explicit stack(typename stack_t::pool_type & shared_pool):
+        stack_t(shared_pool)
+    {}
+};
 
 } /* namespace lockfree */
 } /* namespace boost */
@@ -0,0 +1,208 @@
+//  lock-free unbounded single-producer/single-consumer queue of linked ringbuffer segments
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_UNBOUNDED_RINGBUFFER_HPP_INCLUDED
+#define BOOST_LOCKFREE_UNBOUNDED_RINGBUFFER_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+#include "detail/branch_hints.hpp"
+#include "detail/prefix.hpp"
+
+#include <new>
+
+namespace boost
+{
+namespace lockfree
+{
+
+namespace detail
+{
+
+template <typename T, std::size_t segment_size>
+struct ringbuffer_segment:
+    boost::noncopyable
+{
+    detail::atomic<std::size_t> write_index; /* number of published elements */
+    detail::atomic<ringbuffer_segment*> next;
+    T data[segment_size];
+
+    ringbuffer_segment(void):
+        write_index(0), next(0)
+    {}
+
+    void reset(void)
+    {
+        write_index.store(0, memory_order_relaxed);
+        next.store(0, memory_order_relaxed);
+    }
+};
+
+} /* namespace detail */
+
+/** The unbounded_ringbuffer class provides a single-writer/single-reader queue without capacity limit. Elements are
+ *  stored in fixed-size array segments, which are linked together. The producer only allocates a new segment, when
+ *  the current segment is full, and the consumer hands the last drained segment back to the producer, so that a
+ *  queue, whose fill level stays within a segment, does not allocate memory at all.
+ *
+ *  No operation uses an atomic read-modify-write instruction, each element costs a single release store on the
+ *  producer side and an acquire load on the consumer side, like with the ringbuffer class.
+ *
+ * */
+template <typename T, std::size_t segment_size = 512>
+class unbounded_ringbuffer:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    BOOST_STATIC_ASSERT(segment_size > 0);
+
+    typedef std::size_t size_t;
+    typedef detail::ringbuffer_segment<T, segment_size> segment;
+
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - 2 * sizeof(void*);
+
+    /* producer state */
+    segment * tail_;
+    size_t write_index_;
+    char padding1[padding_size];
+
+    /* consumer state */
+    segment * head_;
+    size_t read_index_;
+    char padding2[padding_size];
+
+    /* single slot for handing a drained segment back to the producer: it is only set by the consumer, if it is
+     * empty, and only cleared by the producer, if it is occupied */
+    detail::atomic<segment*> recycle_;
+    char padding3[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(void*)];
+
+    segment * allocate_segment(void)
+    {
+        segment * ret = recycle_.load(memory_order_acquire);
+        if (ret) {
+            recycle_.store(0, memory_order_relaxed);
+            ret->reset();
+            return ret;
+        }
+        return new(std::nothrow) segment();
+    }
+
+    void recycle_segment(segment * s)
+    {
+        if (recycle_.load(memory_order_relaxed) == 0)
+            recycle_.store(s, memory_order_release);
+        else
+            delete s;
+    }
+#endif
+
+public:
+    /** Constructs an empty queue with one segment
+     *
+     * \throws std::bad_alloc, if the segment cannot be allocated
+     * */
+    unbounded_ringbuffer(void):
+        write_index_(0), read_index_(0), recycle_(0)
+    {
+        tail_ = head_ = new segment();
+    }
+
+    ~unbounded_ringbuffer(void)
+    {
+        segment * s = head_;
+        while (s) {
+            segment * next = s->next.load(memory_order_relaxed);
+            delete s;
+            s = next;
+        }
+        delete recycle_.load(memory_order_relaxed);
+    }
+
+    /** Enqueues object t to the queue. Enqueueing only fails, if the current segment is full and no new segment can
+     *  be allocated.
+     *
+     * \return true, if the enqueue operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if a segment needs to be allocated from the operating system
+     * */
+    bool enqueue(T const & t)
+    {
+        if (unlikely(write_index_ == segment_size)) {
+            segment * next = allocate_segment();
+            if (!next)
+                return false;
+
+            tail_->next.store(next, memory_order_release);
+            tail_ = next;
+            write_index_ = 0;
+        }
+
+        tail_->data[write_index_] = t;
+        ++write_index_;
+        tail_->write_index.store(write_index_, memory_order_release);
+        return true;
+    }
+
+    /** Dequeue object from the queue.
+     *
+     * If dequeue operation is successful, object is written to memory location denoted by ret.
+     *
+     * \return true, if the dequeue operation is successful, false if the queue was empty.
+     *
+     * \note Thread-safe and non-blocking
+     */
+    bool dequeue(T * ret)
+    {
+        if (unlikely(read_index_ == segment_size)) {
+            segment * next = head_->next.load(memory_order_acquire);
+            if (!next)
+                return false;
+
+            recycle_segment(head_);
+            head_ = next;
+            read_index_ = 0;
+        }
+
+        if (read_index_ == head_->write_index.load(memory_order_acquire))
+            return false;
+
+        *ret = head_->data[read_index_];
+        ++read_index_;
+        return true;
+    }
+
+    /**
+     * \return true, if the queue is empty.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void)
+    {
+        if (read_index_ == segment_size)
+            return head_->next.load(memory_order_relaxed) == 0
+                || head_->next.load(memory_order_relaxed)->write_index.load(memory_order_relaxed) == 0;
+        return read_index_ == head_->write_index.load(memory_order_relaxed);
+    }
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return recycle_.is_lock_free();
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_UNBOUNDED_RINGBUFFER_HPP_INCLUDED */
@@ -0,0 +1,307 @@
+//  lock-free work-stealing deque, based on
+//  Chase, D. and Lev, Y., "Dynamic circular work-stealing deque"
+//  and the memory orderings of
+//  Le, N. M., Pop, A., Cohen, A. and Zappa Nardelli, F., "Correct and efficient work-stealing for weak memory models"
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_WORK_STEALING_DEQUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_WORK_STEALING_DEQUE_HPP_INCLUDED
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/freelist.hpp>
+#include <boost/lockfree/policies.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace boost
+{
+namespace lockfree
+{
+
+namespace detail
+{
+
+/* circular array of a work_stealing_deque. arrays, which have been replaced by a larger array, are kept in a list
+ * until the deque is destroyed, because thieves may still read from them */
+template <typename T>
+struct work_stealing_array
+{
+    std::size_t mask;
+    T * data;
+    work_stealing_array * retired; /* previous, smaller array */
+
+    T & operator[](std::ptrdiff_t index)
+    {
+        return data[std::size_t(index) & mask];
+    }
+
+    std::size_t size(void) const
+    {
+        return mask + 1;
+    }
+};
+
+} /* namespace detail */
+
+/** The work_stealing_deque class provides a deque for task schedulers, which is owned by one worker thread. The owner
+ *  pushes and pops elements at the bottom end, while any number of thieves steal elements from the top end.
+ *
+ *  The elements are stored in a circular array. Pushing and popping elements by the owner only uses loads, stores and
+ *  fences, only popping the last element may race with a thief and requires a compare-and-swap. Thieves use a
+ *  compare-and-swap on the top index.
+ *
+ *  The memory management can be controlled via a freelist policy. With struct caching_freelist_t, the owner allocates
+ *  a circular array of twice the size via the allocator policy, when the deque is full. Replaced arrays are not freed
+ *  before the deque is destroyed, their total size is smaller than the size of the current array. With struct
+ *  static_freelist_t, the capacity is fixed and push_bottom fails, if the deque is full.
+ *
+ *  capacity<N> sets the initial size of the array and, unless a freelist policy is given, makes the deque
+ *  fixed-sized. The fixed_sized, allocator and backoff policies are applied like for the fifo class. The positional
+ *  form work_stealing_deque<T, freelist_t, Alloc> is still accepted.
+ *
+ *  \b Limitation: The work_stealing_deque class is limited to PODs
+ *
+ * */
+template <typename T,
+          typename A0 = detail::no_policy,
+          typename A1 = detail::no_policy,
+          typename A2 = detail::no_policy,
+          typename A3 = detail::no_policy
+          >
+class work_stealing_deque:
+    boost::noncopyable
+{
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef detail::container_policies<T, A0, A1, A2, A3> policies;
+    typedef typename policies::freelist_t freelist_t;
+    typedef typename policies::allocator_t Alloc;
+    typedef typename policies::backoff_t backoff_t;
+
+    BOOST_STATIC_ASSERT(boost::is_pod<T>::value);
+    BOOST_STATIC_ASSERT((boost::is_same<freelist_t, caching_freelist_t>::value ||
+                         boost::is_same<freelist_t, static_freelist_t>::value));
+
+    typedef std::ptrdiff_t index_t;
+    typedef detail::work_stealing_array<T> array;
+    typedef typename Alloc::template rebind<array>::other array_allocator;
+
+    static const bool growable = boost::is_same<freelist_t, caching_freelist_t>::value;
+
+    /* thieves */
+    detail::atomic<index_t> top_;
+    char padding1[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(index_t)];
+
+    /* owner */
+    detail::atomic<index_t> bottom_;
+    detail::atomic<array*> array_;
+    char padding2[BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(index_t) - sizeof(array*)];
+
+    Alloc alloc_;
+    array_allocator array_alloc_;
+
+    static std::size_t round_up_to_power_of_two(std::size_t size)
+    {
+        std::size_t ret = 1;
+        while (ret < size)
+            ret *= 2;
+        return ret;
+    }
+
+    array * allocate_array(std::size_t size, array * retired)
+    {
+        array * a = array_alloc_.allocate(1);
+        try {
+            a->data = alloc_.allocate(size);
+        } catch (...) {
+            array_alloc_.deallocate(a, 1);
+            throw;
+        }
+        a->mask = size - 1;
+        a->retired = retired;
+        return a;
+    }
+
+    /* replaces the array by an array of twice the size, the old array is retired */
+    array * grow(array * a, index_t bottom, index_t top)
+    {
+        array * new_array = allocate_array(a->size() * 2, a);
+        for (index_t i = top; i != bottom; ++i)
+            (*new_array)[i] = (*a)[i];
+        array_.store(new_array, memory_order_release);
+        return new_array;
+    }
+#endif
+
+public:
+    /** Construct deque with an initial capacity of 128, or the capacity policy, which is rounded up to a power of two.
+     *
+     * \throws std::bad_alloc, if the array cannot be allocated
+     * */
+    work_stealing_deque(void):
+        top_(0), bottom_(0), array_(0)
+    {
+        std::size_t initial_size = policies::has_capacity ? policies::capacity : 128;
+        array_.store(allocate_array(round_up_to_power_of_two(initial_size), 0), memory_order_relaxed);
+    }
+
+    /** Construct deque with an initial capacity, which is rounded up to a power of two.
+     *
+     * \throws std::bad_alloc, if the array cannot be allocated
+     * */
+    explicit work_stealing_deque(std::size_t initial_size):
+        top_(0), bottom_(0), array_(0)
+    {
+        array_.store(allocate_array(round_up_to_power_of_two(initial_size), 0), memory_order_relaxed);
+    }
+
+    /** Destroys deque, frees the current and all retired arrays.
+     *
+     *  \warning not threadsafe
+     *
+     * */
+    ~work_stealing_deque(void)
+    {
+        array * a = array_.load(memory_order_relaxed);
+        while (a) {
+            array * retired = a->retired;
+            alloc_.deallocate(a->data, a->size());
+            array_alloc_.deallocate(a, 1);
+            a = retired;
+        }
+    }
+
+    //! \copydoc boost::lockfree::fifo::is_lock_free
+    bool is_lock_free(void) const
+    {
+        return top_.is_lock_free() && bottom_.is_lock_free();
+    }
+
+    /**
+     * \return true, if the deque is empty.
+     *
+     * \warning Not thread-safe, use for debugging purposes only
+     * */
+    bool empty(void) const
+    {
+        return bottom_.load(memory_order_relaxed) <= top_.load(memory_order_relaxed);
+    }
+
+    /** Pushes object t to the bottom of the deque.
+     *
+     * \returns true, if the push operation is successful, false if the deque is full and uses static_freelist_t
+     *
+     * \note Only the owner may call push_bottom. Wait-free, unless the array needs to be grown.
+     * \throws std::bad_alloc, if a larger array cannot be allocated
+     * \warning \b Warning: May block if a larger array needs to be allocated from the operating system
+     * */
+    bool push_bottom(T const & t)
+    {
+        index_t bottom = bottom_.load(memory_order_relaxed);
+        index_t top = top_.load(memory_order_acquire);
+        array * a = array_.load(memory_order_relaxed);
+
+        if (unlikely(bottom - top >= index_t(a->size()))) {
+            if (!growable)
+                return false;
+            a = grow(a, bottom, top);
+        }
+
+        (*a)[bottom] = t;
+        detail::atomic_thread_fence(memory_order_release);
+        bottom_.store(bottom + 1, memory_order_relaxed);
+        return true;
+    }
+
+    /** Pops the object, which has been pushed last, from the bottom of the deque.
+     *
+     * if the pop operation is successful, object is written to memory location denoted by ret.
+     *
+     * \returns true, if the pop operation is successful, false if the deque is empty.
+     *
+     * \note Only the owner may call pop_bottom. Wait-free.
+     * */
+    bool pop_bottom(T & ret)
+    {
+        index_t bottom = bottom_.load(memory_order_relaxed) - 1;
+        array * a = array_.load(memory_order_relaxed);
+        bottom_.store(bottom, memory_order_relaxed);
+        detail::atomic_thread_fence(memory_order_seq_cst);
+        index_t top = top_.load(memory_order_relaxed);
+
+        if (unlikely(top > bottom)) {
+            /* empty */
+            bottom_.store(bottom + 1, memory_order_relaxed);
+            return false;
+        }
+
+        ret = (*a)[bottom];
+        if (likely(top != bottom))
+            return true;
+
+        /* last element, race with thieves */
+        bool success = top_.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+        bottom_.store(bottom + 1, memory_order_relaxed);
+        return success;
+    }
+
+    //! \copydoc boost::lockfree::work_stealing_deque::pop_bottom(T&)
+    bool pop_bottom(T * ret)
+    {
+        return pop_bottom(*ret);
+    }
+
+    /** Steals the oldest object from the top of the deque.
+     *
+     * if the steal operation is successful, object is written to memory location denoted by ret.
+     *
+     * \returns true, if the steal operation is successful, false if the deque is empty.
+     *
+     * \note Thread-safe and non-blocking, any thread except the owner may call steal
+     * */
+    bool steal(T & ret)
+    {
+        backoff_t backoff;
+        for (;;) {
+            index_t top = top_.load(memory_order_acquire);
+            detail::atomic_thread_fence(memory_order_seq_cst);
+            index_t bottom = bottom_.load(memory_order_acquire);
+
+            if (top >= bottom)
+                return false;
+
+            array * a = array_.load(memory_order_acquire);
+            T t = (*a)[top];
+            if (top_.compare_exchange_strong(top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+                ret = t;
+                return true;
+            }
+            backoff();
+        }
+    }
+
+    //! \copydoc boost::lockfree::work_stealing_deque::steal(T&)
+    bool steal(T * ret)
+    {
+        return steal(*ret);
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_WORK_STEALING_DEQUE_HPP_INCLUDED */
@@ -0,0 +1,371 @@
+//  work-stealing executor for fork/join parallelism
+//
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Disclaimer: Not a Boost library.
+
+#ifndef BOOST_LOCKFREE_WORK_STEALING_EXECUTOR_HPP_INCLUDED
+#define BOOST_LOCKFREE_WORK_STEALING_EXECUTOR_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/lockfree/deque.hpp>
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/detail/eventcount.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace boost
+{
+namespace lockfree
+{
+
+/** The work_stealing_executor class runs tasks on a fixed number of worker threads.
+ *
+ *  Each worker keeps the tasks, which it spawns, in a deque of its own and executes them in lifo order. Tasks, which
+ *  are spawned by other threads, are enqueued to a global fifo. A worker without tasks dequeues from the global fifo
+ *  and then steals half of the tasks of randomly chosen workers, backing off exponentially between unsuccessful
+ *  rounds. Workers, which do not find any task after the backoff, are parked on an eventcount until a task is
+ *  spawned.
+ *
+ *  Tasks are not copied and not owned by the executor: the executor only stores pointers to them in the deques and
+ *  in the fifo, whose nodes are recycled via node pools. The deques of all workers share one node_pool. Therefore
+ *  spawning tasks does not allocate memory, once the pools have grown to the peak number of queued tasks.
+ *
+ *  Fork/join parallelism is expressed with task groups:
+ *
+ *  \code
+ *  struct fib_task:
+ *      work_stealing_executor::task
+ *  {
+ *      void execute(void)
+ *      {
+ *          ...
+ *          fib_task child(...);
+ *          work_stealing_executor::task_group group;
+ *          executor.spawn(child, group);   // fork
+ *          ...                             // do the other half of the work
+ *          executor.wait(group);           // join, executes other tasks meanwhile
+ *      }
+ *  };
+ *  \endcode
+ *
+ *  \b Limitation: Tasks must not throw exceptions. A task has to stay alive until it has been executed.
+ *
+ * */
+class work_stealing_executor:
+    boost::noncopyable
+{
+public:
+    class task_group;
+
+    //! Base class of tasks.
+    class task
+    {
+    public:
+        task(void):
+            group_(0)
+        {}
+
+        virtual ~task(void)
+        {}
+
+        //! Executes the task.
+        virtual void execute(void) = 0;
+
+    private:
+#ifndef BOOST_DOXYGEN_INVOKED
+        friend class work_stealing_executor;
+
+        task_group * group_;
+#endif
+    };
+
+    //! Counts the spawned, but not yet executed tasks of a fork/join section.
+    class task_group:
+        boost::noncopyable
+    {
+    public:
+        task_group(void):
+            pending_(0)
+        {}
+
+        //! \return true, if all tasks of the group have been executed.
+        bool done(void) const
+        {
+            return pending_.load(memory_order_acquire) == 0;
+        }
+
+    private:
+#ifndef BOOST_DOXYGEN_INVOKED
+        friend class work_stealing_executor;
+
+        detail::atomic<std::size_t> pending_;
+#endif
+    };
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef deque<task*, shared_freelist_t> task_deque;
+
+    static const std::size_t steal_batch_size = 32;
+    static const std::size_t max_backoff_rounds = 10;
+
+    struct worker:
+        boost::noncopyable
+    {
+        worker(task_deque::pool_type & pool, std::size_t index):
+            tasks(pool), index(index), seed(boost::uint32_t(index) * 2654435761u + 1)
+        {}
+
+        task_deque tasks;
+        std::size_t index;
+        boost::uint32_t seed;
+        task * batch[steal_batch_size];
+        char padding[BOOST_LOCKFREE_CACHELINE_BYTES];
+    };
+
+    static void no_cleanup(worker *)
+    {}
+
+    task_deque::pool_type pool_;
+    std::vector<worker*> workers_;
+    fifo<task*> global_;
+    detail::eventcount idle_;
+    detail::atomic<bool> stopping_;
+    boost::thread_specific_ptr<worker> current_;
+    boost::thread_group threads_;
+
+    static boost::uint32_t random(boost::uint32_t & state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    void execute(task & t)
+    {
+        task_group * group = t.group_;
+        t.execute();
+        if (group)
+            group->pending_.fetch_sub(1, memory_order_release);
+    }
+
+    /* steals half of the tasks of up to workers_.size() random victims. the oldest stolen task is returned, the
+     * others are moved to the deque of the thief */
+    /* the global fifo allocates its nodes with a caching freelist, which throws std::bad_alloc instead of failing */
+    void push_global(task * t)
+    {
+        const bool enqueued = global_.enqueue(t);
+        BOOST_ASSERT(enqueued);
+        (void)enqueued;
+    }
+
+    /* push_right fails, if the node pool of the deques cannot provide a node. the task then goes to the global fifo,
+     * so that it is not dropped */
+    void push_local(worker & w, task * t)
+    {
+        if (!w.tasks.push_right(t))
+            push_global(t);
+    }
+
+    task * steal(worker & w)
+    {
+        const std::size_t worker_count = workers_.size();
+        if (worker_count == 1)
+            return 0;
+
+        for (std::size_t attempt = 0; attempt != worker_count; ++attempt) {
+            worker & victim = *workers_[random(w.seed) % worker_count];
+            if (&victim == &w)
+                continue;
+
+            std::size_t count = victim.tasks.steal_half(w.batch, steal_batch_size);
+            if (count == 0)
+                continue;
+
+            for (std::size_t i = 1; i != count; ++i)
+                push_local(w, w.batch[i]);
+            if (count > 1)
+                idle_.notify();
+            return w.batch[0];
+        }
+        return 0;
+    }
+
+    task * find_task(worker & w)
+    {
+        task * t;
+        if (w.tasks.pop_right(t))
+            return t;
+        if (global_.dequeue(&t))
+            return t;
+        return steal(w);
+    }
+
+    static void backoff(std::size_t round)
+    {
+        if (round == max_backoff_rounds - 1) {
+            boost::this_thread::yield();
+            return;
+        }
+
+        for (std::size_t i = 0; i != (std::size_t(1) << round); ++i)
+            detail::spin_pause();
+    }
+
+    void run(worker * w)
+    {
+        current_.reset(w);
+
+        std::size_t idle_rounds = 0;
+        for (;;) {
+            task * t = find_task(*w);
+            if (t) {
+                execute(*t);
+                idle_rounds = 0;
+                continue;
+            }
+
+            if (idle_rounds != max_backoff_rounds) {
+                backoff(idle_rounds++);
+                continue;
+            }
+
+            /* park */
+            boost::uint32_t key = idle_.prepare_wait();
+            t = find_task(*w);
+            if (t) {
+                idle_.cancel_wait();
+                execute(*t);
+                idle_rounds = 0;
+                continue;
+            }
+
+            if (stopping_.load(memory_order_acquire)) {
+                idle_.cancel_wait();
+                break;
+            }
+            idle_.commit_wait(key, boost::posix_time::milliseconds(100));
+        }
+
+        current_.release();
+    }
+
+    void enqueue(task & t)
+    {
+        worker * w = current_.get();
+        if (w)
+            push_local(*w, &t);
+        else
+            push_global(&t);
+        idle_.notify();
+    }
+#endif
+
+public:
+    /** Starts the worker threads.
+     *
+     * \param thread_count number of worker threads, defaults to the number of hardware threads
+     * */
+    explicit work_stealing_executor(std::size_t thread_count = boost::thread::hardware_concurrency()):
+        pool_(128), stopping_(false), current_(&work_stealing_executor::no_cleanup)
+    {
+        thread_count = (std::max)(thread_count, std::size_t(1));
+
+        workers_.reserve(thread_count);
+        for (std::size_t i = 0; i != thread_count; ++i)
+            workers_.push_back(new worker(pool_, i));
+
+        for (std::size_t i = 0; i != thread_count; ++i)
+            threads_.create_thread(boost::bind(&work_stealing_executor::run, this, workers_[i]));
+    }
+
+    /** Executes all remaining tasks and joins the worker threads.
+     *
+     * \warning Must not be called from a worker thread
+     * */
+    ~work_stealing_executor(void)
+    {
+        stopping_.store(true, memory_order_release);
+        idle_.notify();
+        threads_.join_all();
+
+        for (std::size_t i = 0; i != workers_.size(); ++i)
+            delete workers_[i];
+    }
+
+    //! \return number of worker threads
+    std::size_t thread_count(void) const
+    {
+        return workers_.size();
+    }
+
+    /** Spawns task t as part of group. If called from a worker thread, t is pushed to the deque of the worker,
+     *  otherwise to the global fifo.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if a queue node needs to be allocated from the operating system
+     * */
+    void spawn(task & t, task_group & group)
+    {
+        group.pending_.fetch_add(1, memory_order_relaxed);
+        t.group_ = &group;
+        enqueue(t);
+    }
+
+    /** Spawns task t, which does not belong to any group.
+     *
+     * \note Thread-safe and non-blocking
+     * \warning \b Warning: May block if a queue node needs to be allocated from the operating system
+     * */
+    void submit(task & t)
+    {
+        t.group_ = 0;
+        enqueue(t);
+    }
+
+    /** Waits until all tasks of group have been executed. A worker thread executes other tasks while waiting, other
+     *  threads yield.
+     * */
+    void wait(task_group & group)
+    {
+        worker * w = current_.get();
+        std::size_t idle_rounds = 0;
+
+        while (!group.done()) {
+            if (w) {
+                task * t = find_task(*w);
+                if (t) {
+                    execute(*t);
+                    idle_rounds = 0;
+                    continue;
+                }
+            }
+
+            backoff(idle_rounds);
+            if (idle_rounds != max_backoff_rounds - 1)
+                ++idle_rounds;
+        }
+    }
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_WORK_STEALING_EXECUTOR_HPP_INCLUDED */
@@ -0,0 +1,77 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  measures the wake-up latency of the blocking_ringbuffer and the cost of its non-blocking operations
+
+#include <boost/lockfree/blocking_ringbuffer.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iostream>
+
+using namespace boost::lockfree;
+using boost::posix_time::microsec_clock;
+using boost::posix_time::ptime;
+
+static const int ping_pong_rounds = 10000;
+
+/* every round blocks both threads, so the round trip time is dominated by two wake-ups */
+struct ping_pong_benchmark
+{
+    blocking_ringbuffer<int, 2> ping, pong;
+
+    void echo(void)
+    {
+        for (int i = 0; i != ping_pong_rounds; ++i) {
+            int data;
+            ping.wait_dequeue(&data);
+            pong.wait_enqueue(data);
+        }
+    }
+
+    long run(void)
+    {
+        boost::thread echo_thread(boost::bind(&ping_pong_benchmark::echo, this));
+
+        ptime start = microsec_clock::universal_time();
+        for (int i = 0; i != ping_pong_rounds; ++i) {
+            int data;
+            ping.wait_enqueue(i);
+            pong.wait_dequeue(&data);
+        }
+        ptime end = microsec_clock::universal_time();
+
+        echo_thread.join();
+        return long((end - start).total_microseconds() * 1000 / ping_pong_rounds);
+    }
+};
+
+template <typename ringbuffer_type>
+long non_blocking_cost(ringbuffer_type & rb)
+{
+    const int iterations = 1000000;
+    ptime start = microsec_clock::universal_time();
+    for (int i = 0; i != iterations; ++i) {
+        int data;
+        rb.enqueue(i);
+        rb.dequeue(&data);
+    }
+    ptime end = microsec_clock::universal_time();
+    return long((end - start).total_microseconds() * 1000 / iterations);
+}
+
+int main(void)
+{
+    ping_pong_benchmark ping_pong;
+    std::cout << "blocking round trip: " << ping_pong.run() << " ns" << std::endl;
+
+    ringbuffer<int, 64> plain;
+    blocking_ringbuffer<int, 64> blocking;
+
+    std::cout << "enqueue/dequeue pair, ringbuffer: " << non_blocking_cost(plain) << " ns, "
+              << "blocking_ringbuffer: " << non_blocking_cost(blocking) << " ns" << std::endl;
+}
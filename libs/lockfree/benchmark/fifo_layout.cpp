@@ -0,0 +1,98 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  compares the padded and the packed node layout of the fifo
+
+#include <boost/lockfree/fifo.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdlib>
+#include <iostream>
+
+using namespace boost::lockfree;
+using boost::posix_time::microsec_clock;
+using boost::posix_time::ptime;
+
+template <typename node_layout>
+struct fifo_layout_benchmark
+{
+    typedef fifo<std::size_t, caching_freelist_t, std::allocator<std::size_t>, node_layout> fifo_type;
+
+    static const std::size_t deep_elements = 1000000;
+    static const std::size_t shallow_elements = 200000;
+    static const std::size_t shallow_depth = 4;
+
+    fifo_type sf;
+    boost::atomic<std::size_t> dequeued;
+
+    fifo_layout_benchmark(void):
+        sf(deep_elements), dequeued(0)
+    {}
+
+    /* the whole backlog is enqueued before it is drained, the consumer walks a long chain of nodes */
+    long deep(void)
+    {
+        ptime start = microsec_clock::universal_time();
+        for (std::size_t i = 0; i != deep_elements; ++i)
+            sf.enqueue(i);
+
+        std::size_t out;
+        for (std::size_t i = 0; i != deep_elements; ++i) {
+            if (!sf.dequeue(&out) || out != i) {
+                std::cerr << "fifo returned the wrong element" << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        ptime end = microsec_clock::universal_time();
+        return (end - start).total_microseconds() * 1000 / deep_elements;
+    }
+
+    void consume(void)
+    {
+        std::size_t out;
+        for (std::size_t i = 0; i != shallow_elements; ++i) {
+            while (!sf.dequeue(&out))
+                boost::this_thread::yield();
+            dequeued.store(i + 1, boost::memory_order_release);
+        }
+    }
+
+    /* producer and consumer run concurrently and touch neighboring nodes of an almost empty fifo */
+    long shallow(void)
+    {
+        ptime start = microsec_clock::universal_time();
+        boost::thread consumer(boost::bind(&fifo_layout_benchmark::consume, this));
+
+        for (std::size_t i = 0; i != shallow_elements; ++i) {
+            while (i - dequeued.load(boost::memory_order_acquire) >= shallow_depth)
+                boost::this_thread::yield();
+            sf.enqueue(i);
+        }
+        consumer.join();
+
+        ptime end = microsec_clock::universal_time();
+        return (end - start).total_microseconds() * 1000 / shallow_elements;
+    }
+
+    static void run(const char * name)
+    {
+        fifo_layout_benchmark bench;
+        long deep = bench.deep();
+        long shallow = bench.shallow();
+
+        std::cout << name << " nodes: " << sizeof(detail::fifo_node<std::size_t, node_layout>) << " bytes per element, "
+                  << "deep fifo: " << deep << "ns per element, "
+                  << "shallow fifo: " << shallow << "ns per element" << std::endl;
+    }
+};
+
+int main(void)
+{
+    fifo_layout_benchmark<padded_node_t>::run("padded");
+    fifo_layout_benchmark<packed_node_t>::run("packed");
+}
@@ -0,0 +1,64 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  measures push/pop pairs on a contended stack
+
+#include <boost/lockfree/stack.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdlib>
+#include <iostream>
+
+using boost::posix_time::microsec_clock;
+using boost::posix_time::ptime;
+
+struct stack_benchmark
+{
+    static const long operations = 1000000;
+    static const int thread_count = 2;
+
+    boost::lockfree::stack<long> stk;
+
+    stack_benchmark(void):
+        stk(128)
+    {}
+
+    /* every thread pushes a node and pops a node, which is usually the node of another thread */
+    void push_pop(void)
+    {
+        long out;
+        for (long i = 0; i != operations; ++i) {
+            stk.push(i);
+            stk.pop(&out);
+        }
+    }
+
+    long run(int threads)
+    {
+        ptime start = microsec_clock::universal_time();
+        boost::thread_group group;
+        for (int i = 0; i != threads; ++i)
+            group.create_thread(boost::bind(&stack_benchmark::push_pop, this));
+        group.join_all();
+        ptime end = microsec_clock::universal_time();
+
+        if (!stk.empty()) {
+            std::cerr << "stack is not empty" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        return (end - start).total_microseconds() * 1000 / (operations * threads);
+    }
+};
+
+int main(void)
+{
+    stack_benchmark bench;
+    std::cout << "stack push/pop with 1 thread: " << bench.run(1) << "ns per pair, "
+              << "with " << stack_benchmark::thread_count << " threads: "
+              << bench.run(stack_benchmark::thread_count) << "ns per pair" << std::endl;
+}
@@ -0,0 +1,173 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  compares fork/join computations on the work_stealing_executor with their serial versions
+
+#include <boost/lockfree/work_stealing_executor.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using boost::lockfree::work_stealing_executor;
+using boost::posix_time::microsec_clock;
+using boost::posix_time::ptime;
+
+typedef work_stealing_executor::task task;
+typedef work_stealing_executor::task_group task_group;
+
+static const unsigned int fib_cutoff = 20;
+
+static unsigned long serial_fib(unsigned int n)
+{
+    return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+}
+
+/* the child tasks live on the stack of their parent, spawning does not allocate */
+struct fib_task:
+    task
+{
+    work_stealing_executor & executor;
+    unsigned int n;
+    unsigned long * result;
+
+    fib_task(work_stealing_executor & executor, unsigned int n, unsigned long * result):
+        executor(executor), n(n), result(result)
+    {}
+
+    void execute(void)
+    {
+        if (n < fib_cutoff) {
+            *result = serial_fib(n);
+            return;
+        }
+
+        unsigned long x, y;
+        fib_task left(executor, n - 1, &x);
+        fib_task right(executor, n - 2, &y);
+
+        task_group group;
+        executor.spawn(left, group);
+        right.execute();
+        executor.wait(group);
+
+        *result = x + y;
+    }
+};
+
+static const std::size_t reduce_grain = 4096;
+
+/* recursively splits the range until it is smaller than the grain size */
+struct reduce_task:
+    task
+{
+    work_stealing_executor & executor;
+    const int * begin;
+    const int * end;
+    long long * result;
+
+    reduce_task(work_stealing_executor & executor, const int * begin, const int * end, long long * result):
+        executor(executor), begin(begin), end(end), result(result)
+    {}
+
+    void execute(void)
+    {
+        if (std::size_t(end - begin) <= reduce_grain) {
+            long long sum = 0;
+            for (const int * it = begin; it != end; ++it)
+                sum += *it;
+            *result = sum;
+            return;
+        }
+
+        const int * middle = begin + (end - begin) / 2;
+        long long x, y;
+        reduce_task left(executor, begin, middle, &x);
+        reduce_task right(executor, middle, end, &y);
+
+        task_group group;
+        executor.spawn(left, group);
+        right.execute();
+        executor.wait(group);
+
+        *result = x + y;
+    }
+};
+
+template <typename Result>
+static void check(Result result, Result expected)
+{
+    if (result != expected) {
+        std::cerr << "wrong result: " << result << ", expected " << expected << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+}
+
+static void fib_benchmark(void)
+{
+    const unsigned int n = 36;
+
+    ptime start = microsec_clock::universal_time();
+    unsigned long expected = serial_fib(n);
+    ptime end = microsec_clock::universal_time();
+    std::cout << "serial fib(" << n << "): " << (end - start).total_milliseconds() << "ms" << std::endl;
+
+    for (std::size_t threads = 1; threads <= 4; threads *= 2) {
+        work_stealing_executor executor(threads);
+
+        unsigned long result = 0;
+        fib_task root(executor, n, &result);
+        task_group group;
+
+        start = microsec_clock::universal_time();
+        executor.spawn(root, group);
+        executor.wait(group);
+        end = microsec_clock::universal_time();
+
+        check(result, expected);
+        std::cout << "parallel fib(" << n << ") with " << threads << " threads: "
+                  << (end - start).total_milliseconds() << "ms" << std::endl;
+    }
+}
+
+static void reduce_benchmark(void)
+{
+    const std::size_t size = 1 << 24;
+    std::vector<int> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = int(i % 1000);
+
+    ptime start = microsec_clock::universal_time();
+    long long expected = 0;
+    for (std::size_t i = 0; i != size; ++i)
+        expected += data[i];
+    ptime end = microsec_clock::universal_time();
+    std::cout << "serial reduce of " << size << " elements: " << (end - start).total_milliseconds() << "ms" << std::endl;
+
+    for (std::size_t threads = 1; threads <= 4; threads *= 2) {
+        work_stealing_executor executor(threads);
+
+        long long result = 0;
+        reduce_task root(executor, &data[0], &data[0] + size, &result);
+        task_group group;
+
+        start = microsec_clock::universal_time();
+        executor.spawn(root, group);
+        executor.wait(group);
+        end = microsec_clock::universal_time();
+
+        check(result, expected);
+        std::cout << "parallel reduce of " << size << " elements with " << threads << " threads: "
+                  << (end - start).total_milliseconds() << "ms" << std::endl;
+    }
+}
+
+int main(void)
+{
+    fib_benchmark();
+    reduce_benchmark();
+}
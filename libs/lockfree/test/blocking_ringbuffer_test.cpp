@@ -0,0 +1,116 @@
+#include <boost/lockfree/blocking_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+using boost::posix_time::milliseconds;
+
+
+BOOST_AUTO_TEST_CASE( blocking_ringbuffer_timeout_test )
+{
+    blocking_ringbuffer<int, 4> f;
+
+    int out;
+    BOOST_REQUIRE(!f.wait_dequeue(&out, milliseconds(10)));
+
+    BOOST_REQUIRE(f.wait_enqueue(1, milliseconds(10)));
+    BOOST_REQUIRE(f.wait_enqueue(2, milliseconds(10)));
+    BOOST_REQUIRE(f.wait_enqueue(3, milliseconds(10)));
+    BOOST_REQUIRE(!f.wait_enqueue(4, milliseconds(10)));
+
+    BOOST_REQUIRE(f.wait_dequeue(&out, milliseconds(10)));
+    BOOST_REQUIRE_EQUAL(out, 1);
+}
+
+static const int nodes_per_thread = 100000;
+
+struct blocking_ringbuffer_tester
+{
+    blocking_ringbuffer<int, 0> sf;
+
+    blocking_ringbuffer_tester(void):
+        sf(16)
+    {}
+
+    void add(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            sf.wait_enqueue(i);
+            if (i % 1024 == 0)
+                boost::this_thread::sleep(boost::posix_time::microseconds(100));
+        }
+    }
+
+    void get(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            int data;
+            sf.wait_dequeue(&data);
+            BOOST_REQUIRE_EQUAL(data, i);
+        }
+    }
+
+    void run(void)
+    {
+        thread reader(boost::bind(&blocking_ringbuffer_tester::get, this));
+        thread writer(boost::bind(&blocking_ringbuffer_tester::add, this));
+
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE(sf.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( blocking_ringbuffer_test )
+{
+    blocking_ringbuffer_tester test1;
+    test1.run();
+}
+
+static const int ping_pong_rounds = 10000;
+
+/* every round blocks both threads, so each wait has to be woken up by the other thread */
+struct ping_pong_tester
+{
+    blocking_ringbuffer<int, 2> ping, pong;
+
+    void echo(void)
+    {
+        for (int i = 0; i != ping_pong_rounds; ++i) {
+            int data;
+            ping.wait_dequeue(&data);
+            pong.wait_enqueue(data);
+        }
+    }
+
+    void run(void)
+    {
+        thread echo_thread(boost::bind(&ping_pong_tester::echo, this));
+
+        for (int i = 0; i != ping_pong_rounds; ++i) {
+            int data;
+            ping.wait_enqueue(i);
+            pong.wait_dequeue(&data);
+            BOOST_REQUIRE_EQUAL(data, i);
+        }
+
+        echo_thread.join();
+        BOOST_REQUIRE(ping.empty());
+        BOOST_REQUIRE(pong.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( blocking_ringbuffer_ping_pong_test )
+{
+    ping_pong_tester test1;
+    test1.run();
+}
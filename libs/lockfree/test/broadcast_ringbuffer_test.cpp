@@ -0,0 +1,121 @@
+#include <boost/lockfree/broadcast_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <boost/scoped_ptr.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( simple_broadcast_ringbuffer_test )
+{
+    broadcast_ringbuffer<int, 4> f(2);
+
+    BOOST_REQUIRE_EQUAL(f.consumers(), 2u);
+    BOOST_REQUIRE(f.empty(0));
+    BOOST_REQUIRE(f.empty(1));
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+    BOOST_REQUIRE(!f.enqueue(4)); /* full */
+
+    int out;
+    for (int i = 0; i != 4; ++i) {
+        BOOST_REQUIRE(f.dequeue(0, &out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(f.empty(0));
+    BOOST_REQUIRE(!f.dequeue(0, &out));
+
+    /* gated on the slowest consumer */
+    BOOST_REQUIRE(!f.enqueue(4));
+
+    BOOST_REQUIRE(f.dequeue(1, &out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+    BOOST_REQUIRE(f.enqueue(4));
+    BOOST_REQUIRE(!f.enqueue(5));
+
+    BOOST_REQUIRE(f.dequeue(0, &out));
+    BOOST_REQUIRE_EQUAL(out, 4);
+}
+
+BOOST_AUTO_TEST_CASE( broadcast_ringbuffer_front_test )
+{
+    broadcast_ringbuffer<int, 0> f(8, 3);
+
+    BOOST_REQUIRE(f.enqueue(42));
+
+    int const * first = f.front(0);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE_EQUAL(*first, 42);
+
+    /* all consumers see the same slot */
+    BOOST_REQUIRE_EQUAL(f.front(1), first);
+    BOOST_REQUIRE_EQUAL(f.front(2), first);
+
+    f.pop(0);
+    BOOST_REQUIRE(!f.front(0));
+    BOOST_REQUIRE(f.front(1));
+}
+
+static const int nodes_per_thread = 100000;
+static const int consumer_count = 3;
+
+struct broadcast_ringbuffer_tester
+{
+    broadcast_ringbuffer<int, 0> sf;
+    long sums[consumer_count];
+
+    broadcast_ringbuffer_tester(void):
+        sf(64, consumer_count)
+    {}
+
+    void add(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i)
+            while (!sf.enqueue(i))
+                boost::this_thread::yield();
+    }
+
+    void get(int consumer)
+    {
+        long sum = 0;
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            int const * element;
+            while (!(element = sf.front(consumer)))
+                boost::this_thread::yield();
+            BOOST_REQUIRE_EQUAL(*element, i);
+            sum += *element;
+            sf.pop(consumer);
+        }
+        sums[consumer] = sum;
+    }
+
+    void run(void)
+    {
+        thread_group readers;
+        for (int i = 0; i != consumer_count; ++i)
+            readers.create_thread(boost::bind(&broadcast_ringbuffer_tester::get, this, i));
+        thread writer(boost::bind(&broadcast_ringbuffer_tester::add, this));
+
+        writer.join();
+        readers.join_all();
+
+        const long expected = long(nodes_per_thread) * (nodes_per_thread - 1) / 2;
+        for (int i = 0; i != consumer_count; ++i) {
+            BOOST_REQUIRE_EQUAL(sums[i], expected);
+            BOOST_REQUIRE(sf.empty(i));
+        }
+    }
+};
+
+BOOST_AUTO_TEST_CASE( broadcast_ringbuffer_test )
+{
+    scoped_ptr<broadcast_ringbuffer_tester> test1(new broadcast_ringbuffer_tester);
+    test1->run();
+}
@@ -0,0 +1,91 @@
+#include <boost/lockfree/compact_fifo.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/scoped_array.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include "fifo_tester.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( simple_compact_fifo_test )
+{
+    compact_fifo<int> f;
+
+    BOOST_WARN(f.is_lock_free());
+
+    BOOST_REQUIRE(f.empty());
+    int out;
+    BOOST_REQUIRE(!f.dequeue(&out));
+
+    f.enqueue(1);
+    f.enqueue(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.dequeue(&i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.dequeue(&i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( compact_fifo_many_queues_test )
+{
+    const int queue_count = 100000;
+    scoped_array<compact_fifo<int> > queues(new compact_fifo<int>[queue_count]);
+
+    /* two tagged pointers and a reference to the pool */
+    BOOST_REQUIRE(sizeof(compact_fifo<int>) <= 2 * sizeof(tagged_ptr<int>) + sizeof(void*));
+
+    for (int i = 0; i < queue_count; i += 7)
+        BOOST_REQUIRE(queues[i].enqueue(i));
+
+    for (int i = 0; i != queue_count; ++i) {
+        int out;
+        if (i % 7 == 0) {
+            BOOST_REQUIRE(queues[i].dequeue(&out));
+            BOOST_REQUIRE_EQUAL(out, i);
+        }
+        BOOST_REQUIRE(!queues[i].dequeue(&out));
+        BOOST_REQUIRE(queues[i].empty());
+    }
+}
+
+/* default-constructed fifos of value types with the same size and alignment use the same process-wide pool */
+BOOST_STATIC_ASSERT((boost::is_same<compact_fifo<int>::pool_type, compact_fifo<float>::pool_type>::value));
+
+BOOST_AUTO_TEST_CASE( compact_fifo_shared_pool_test )
+{
+    compact_fifo<int>::pool_type pool;
+    compact_fifo<int> f1(pool), f2(pool);
+
+    /* an unused fifo can be marked as idle */
+    BOOST_REQUIRE(f1.try_sleep());
+    bool was_idle = false;
+    BOOST_REQUIRE(f1.enqueue_notify(1, was_idle));
+    BOOST_REQUIRE(was_idle);
+
+    BOOST_REQUIRE(f2.enqueue(2));
+
+    int out;
+    BOOST_REQUIRE(f1.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 1);
+    BOOST_REQUIRE(f2.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 2);
+    BOOST_REQUIRE(!f1.dequeue(&out));
+}
+
+BOOST_AUTO_TEST_CASE( compact_fifo_test )
+{
+    fifo_tester<compact_fifo<int> > test1;
+    test1.run();
+}
@@ -15,6 +15,7 @@
 #include <boost/thread/thread.hpp>
 #include <boost/lockfree/deque.hpp>
 #include <boost/program_options.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 #include <hpx/util/lightweight_test.hpp>
 
@@ -32,6 +33,9 @@ std::size_t consumer_thread_count = 4;
 
 volatile bool done = false;
 
+using boost::posix_time::microsec_clock;
+using boost::posix_time::ptime;
+
 void left_producer()
 {
     for (std::size_t i = 0; i != iterations; ++i) {
@@ -123,6 +127,8 @@ int main(int argc, char** argv)
 
         boost::thread_group producer_threads, consumer_threads;
 
+        ptime start = microsec_clock::universal_time();
+
         for (std::size_t i = 0; i != producer_thread_count; ++i)
             producer_threads.create_thread(left_producer);
 
@@ -134,6 +140,10 @@ int main(int argc, char** argv)
 
         consumer_threads.join_all();
 
+        ptime end = microsec_clock::universal_time();
+        std::cout << "elapsed: " << (end - start).total_milliseconds()
+                  << "ms" << std::endl;
+
         HPX_TEST_EQ(left_producer_count, right_consumer_count);
 
         std::cout << "produced " << left_producer_count
@@ -142,12 +152,16 @@ int main(int argc, char** argv)
                   << " objects on the right"
                   << std::endl;
     }
-    
+
+    done = false;
+
     { // right in, left out
         std::cout << "right in, left out" << std::endl;
 
         boost::thread_group producer_threads, consumer_threads;
 
+        ptime start = microsec_clock::universal_time();
+
         for (std::size_t i = 0; i != producer_thread_count; ++i)
             producer_threads.create_thread(right_producer);
 
@@ -159,6 +173,10 @@ int main(int argc, char** argv)
 
         consumer_threads.join_all();
 
+        ptime end = microsec_clock::universal_time();
+        std::cout << "elapsed: " << (end - start).total_milliseconds()
+                  << "ms" << std::endl;
+
         HPX_TEST_EQ(right_producer_count, left_consumer_count);
 
         std::cout << "produced " << right_producer_count
@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "CAS-Based Lock-Free Algorithm for Shared Deques"
+//  by M. M. Michael
+//  Link: http://www.research.ibm.com/people/m/michael/europar-2003.pdf
+//
+//  C++ implementation - Copyright (C) 2011      Bryce Lelbach
+//  Test               - Copyright (C) 2026      agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/thread.hpp>
+#include <boost/lockfree/deque.hpp>
+#include <boost/program_options.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+typedef boost::lockfree::deque<
+    std::size_t, boost::lockfree::indexed_freelist_t
+> indexed_deque;
+
+boost::atomic<std::size_t> left_producer_count(0);
+boost::atomic<std::size_t> right_producer_count(0);
+
+boost::atomic<std::size_t> left_consumer_count(0);
+boost::atomic<std::size_t> right_consumer_count(0);
+
+std::size_t capacity = 1024;
+
+indexed_deque* deque = 0;
+
+std::size_t iterations = 100000;
+std::size_t producer_thread_count = 4;
+std::size_t consumer_thread_count = 4;
+
+volatile bool done = false;
+
+// The deque has a fixed capacity, so producers retry until the consumers have
+// made room.
+void left_producer()
+{
+    for (std::size_t i = 0; i != iterations; ++i) {
+        std::size_t value = ++left_producer_count;
+        while (!deque->push_left(value))
+            boost::this_thread::yield();
+    }
+}
+
+void right_producer()
+{
+    for (std::size_t i = 0; i != iterations; ++i) {
+        std::size_t value = ++right_producer_count;
+        while (!deque->push_right(value))
+            boost::this_thread::yield();
+    }
+}
+
+void left_consumer()
+{
+    std::size_t value(0);
+    while (!done) {
+        while (deque->pop_left(value))
+            ++left_consumer_count;
+    }
+
+    while (deque->pop_left(value))
+        ++left_consumer_count;
+}
+
+void right_consumer()
+{
+    std::size_t value(0);
+    while (!done) {
+        while (deque->pop_right(value))
+            ++right_consumer_count;
+    }
+
+    while (deque->pop_right(value))
+        ++right_consumer_count;
+}
+
+void sequential_test()
+{
+    indexed_deque d(4);
+
+    for (std::size_t i = 0; i != 4; ++i)
+        HPX_TEST(d.push_right(i));
+
+    // the capacity is exhausted
+    HPX_TEST(!d.push_right(4));
+    HPX_TEST(!d.push_left(4));
+
+    std::size_t value(0);
+    HPX_TEST(d.pop_left(value));
+    HPX_TEST_EQ(value, 0U);
+    HPX_TEST(d.pop_right(value));
+    HPX_TEST_EQ(value, 3U);
+
+    HPX_TEST(d.push_left(5));
+    HPX_TEST(d.pop_left(value));
+    HPX_TEST_EQ(value, 5U);
+
+    HPX_TEST(d.pop_left(value));
+    HPX_TEST_EQ(value, 1U);
+    HPX_TEST(d.pop_left(value));
+    HPX_TEST_EQ(value, 2U);
+    HPX_TEST(!d.pop_left(value));
+    HPX_TEST(d.empty());
+
+    // without capacity policy, the anchor cannot address more than 2^16 - 1
+    // nodes
+    bool rejected = false;
+    try {
+        indexed_deque too_large(std::size_t(1) << 16);
+    }
+    catch (std::length_error const&) {
+        rejected = true;
+    }
+    HPX_TEST(rejected);
+}
+
+int main(int argc, char** argv)
+{
+    using boost::program_options::variables_map;
+    using boost::program_options::options_description;
+    using boost::program_options::value;
+    using boost::program_options::store;
+    using boost::program_options::command_line_parser;
+    using boost::program_options::notify;
+
+    variables_map vm;
+
+    options_description
+        desc_cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_cmdline.add_options()
+        ("help,h", "print out program usage (this message)")
+        ("producer-threads,p", value<std::size_t>(),
+         "the number of worker threads inserting objects into the deque "
+         "(default: 4)")
+        ("consumer-threads,c", value<std::size_t>(),
+         "the number of worker threads removing objects into the deque "
+         "(default: 4)")
+        ("capacity", value<std::size_t>(),
+         "the number of nodes of the deque (default: 1024)")
+        ("iterations,i", value<std::size_t>(),
+         "the number of iterations (default: 100000)")
+    ;
+
+    store(command_line_parser(argc, argv).options(desc_cmdline).run(), vm);
+
+    notify(vm);
+
+    // print help screen
+    if (vm.count("help"))
+    {
+        std::cout << desc_cmdline;
+        return hpx::util::report_errors();
+    }
+
+    if (vm.count("consumer-threads"))
+        consumer_thread_count = vm["consumer-threads"].as<std::size_t>();
+
+    if (vm.count("producer-threads"))
+        producer_thread_count = vm["producer-threads"].as<std::size_t>();
+
+    if (vm.count("capacity"))
+        capacity = vm["capacity"].as<std::size_t>();
+
+    if (vm.count("iterations"))
+        iterations = vm["iterations"].as<std::size_t>();
+
+    sequential_test();
+
+    indexed_deque d(capacity);
+    deque = &d;
+
+    std::cout << "boost::lockfree::deque with indexed_freelist_t is ";
+    if (!deque->is_lock_free())
+        std::cout << "not ";
+    std::cout << "lockfree" << std::endl;
+
+    { // left in, right out
+        std::cout << "left in, right out" << std::endl;
+
+        boost::thread_group producer_threads, consumer_threads;
+
+        for (std::size_t i = 0; i != producer_thread_count; ++i)
+            producer_threads.create_thread(left_producer);
+
+        for (std::size_t i = 0; i != consumer_thread_count; ++i)
+            consumer_threads.create_thread(right_consumer);
+
+        producer_threads.join_all();
+        done = true;
+
+        consumer_threads.join_all();
+
+        HPX_TEST_EQ(left_producer_count, right_consumer_count);
+
+        std::cout << "produced " << left_producer_count
+                  << " objects on the left\n"
+                  << "consumed " << right_consumer_count
+                  << " objects on the right"
+                  << std::endl;
+    }
+
+    done = false;
+
+    { // right in, left out
+        std::cout << "right in, left out" << std::endl;
+
+        boost::thread_group producer_threads, consumer_threads;
+
+        for (std::size_t i = 0; i != producer_thread_count; ++i)
+            producer_threads.create_thread(right_producer);
+
+        for (std::size_t i = 0; i != consumer_thread_count; ++i)
+            consumer_threads.create_thread(left_consumer);
+
+        producer_threads.join_all();
+        done = true;
+
+        consumer_threads.join_all();
+
+        HPX_TEST_EQ(right_producer_count, left_consumer_count);
+
+        std::cout << "produced " << right_producer_count
+                  << " objects on the right\n"
+                  << "consumed " << left_consumer_count
+                  << " objects on the left"
+                  << std::endl;
+    }
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "CAS-Based Lock-Free Algorithm for Shared Deques"
+//  by M. M. Michael
+//  Link: http://www.research.ibm.com/people/m/michael/europar-2003.pdf
+//
+//  C++ implementation - Copyright (C) 2011      Bryce Lelbach
+//  Test               - Copyright (C) 2026      agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+#include <boost/lockfree/deque.hpp>
+#include <boost/program_options.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+boost::atomic<std::size_t> producer_count(0);
+boost::atomic<std::size_t> producer_sum(0);
+
+boost::atomic<std::size_t> owner_count(0);
+boost::atomic<std::size_t> thief_count(0);
+boost::atomic<std::size_t> consumer_sum(0);
+boost::atomic<std::size_t> steals(0);
+
+boost::lockfree::deque<std::size_t> deque;
+
+std::size_t iterations = 1000000;
+std::size_t thief_thread_count = 4;
+std::size_t batch_size = 64;
+
+volatile bool done = false;
+
+// The owner pushes and pops on the right, like a worker of a work-stealing
+// scheduler.
+void owner()
+{
+    std::size_t value(0);
+    for (std::size_t i = 0; i != iterations; ++i) {
+        value = ++producer_count;
+        producer_sum += value;
+        deque.push_right(value);
+
+        if (i % 4 == 0 && deque.pop_right(value)) {
+            ++owner_count;
+            consumer_sum += value;
+        }
+    }
+}
+
+// Thieves take batches from the left.
+void thief()
+{
+    std::vector<std::size_t> batch(batch_size);
+    while (true) {
+        bool finished = done;
+
+        std::size_t count = deque.steal_half(&batch[0], batch_size);
+        if (count == 0) {
+            if (finished)
+                return;
+            continue;
+        }
+
+        ++steals;
+        thief_count += count;
+
+        // Each batch is a contiguous range of the deque, so its elements are
+        // increasing.
+        for (std::size_t i = 0; i != count; ++i) {
+            if (i != 0)
+                HPX_TEST_LT(batch[i - 1], batch[i]);
+            consumer_sum += batch[i];
+        }
+    }
+}
+
+void sequential_test()
+{
+    boost::lockfree::deque<std::size_t> d;
+    std::size_t batch[16];
+
+    HPX_TEST_EQ(d.steal_half(batch, 16), 0U);
+
+    for (std::size_t i = 1; i != 11; ++i)
+        d.push_right(i);
+
+    // 10 elements, steal 5
+    HPX_TEST_EQ(d.steal_half(batch, 16), 5U);
+    for (std::size_t i = 0; i != 5; ++i)
+        HPX_TEST_EQ(batch[i], i + 1);
+
+    // 5 elements, steal 3, but at most 2
+    HPX_TEST_EQ(d.steal_half(batch, 2), 2U);
+    HPX_TEST_EQ(batch[0], 6U);
+    HPX_TEST_EQ(batch[1], 7U);
+
+    // 3 elements, steal 2
+    HPX_TEST_EQ(d.steal_half(batch, 16), 2U);
+    HPX_TEST_EQ(batch[0], 8U);
+    HPX_TEST_EQ(batch[1], 9U);
+
+    // 1 element, steal it
+    HPX_TEST_EQ(d.steal_half(batch, 16), 1U);
+    HPX_TEST_EQ(batch[0], 10U);
+
+    HPX_TEST(d.empty());
+    HPX_TEST_EQ(d.steal_half(batch, 16), 0U);
+
+    // the deque is still usable
+    d.push_left(42);
+    std::size_t value(0);
+    HPX_TEST(d.pop_right(value));
+    HPX_TEST_EQ(value, 42U);
+}
+
+int main(int argc, char** argv)
+{
+    using boost::program_options::variables_map;
+    using boost::program_options::options_description;
+    using boost::program_options::value;
+    using boost::program_options::store;
+    using boost::program_options::command_line_parser;
+    using boost::program_options::notify;
+
+    variables_map vm;
+
+    options_description
+        desc_cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_cmdline.add_options()
+        ("help,h", "print out program usage (this message)")
+        ("thief-threads,t", value<std::size_t>(),
+         "the number of worker threads stealing objects from the deque "
+         "(default: 4)")
+        ("batch-size,b", value<std::size_t>(),
+         "the maximum number of objects stolen at once (default: 64)")
+        ("iterations,i", value<std::size_t>(),
+         "the number of iterations (default: 1000000)")
+    ;
+
+    store(command_line_parser(argc, argv).options(desc_cmdline).run(), vm);
+
+    notify(vm);
+
+    // print help screen
+    if (vm.count("help"))
+    {
+        std::cout << desc_cmdline;
+        return hpx::util::report_errors();
+    }
+
+    if (vm.count("thief-threads"))
+        thief_thread_count = vm["thief-threads"].as<std::size_t>();
+
+    if (vm.count("batch-size"))
+        batch_size = vm["batch-size"].as<std::size_t>();
+
+    if (vm.count("iterations"))
+        iterations = vm["iterations"].as<std::size_t>();
+
+    sequential_test();
+
+    { // owner on the right, thieves on the left
+        std::cout << "owner on the right, thieves on the left" << std::endl;
+
+        boost::thread_group thief_threads;
+
+        for (std::size_t i = 0; i != thief_thread_count; ++i)
+            thief_threads.create_thread(thief);
+
+        owner();
+        done = true;
+
+        thief_threads.join_all();
+
+        HPX_TEST_EQ(producer_count, owner_count + thief_count);
+        HPX_TEST_EQ(producer_sum, consumer_sum);
+        HPX_TEST(deque.empty());
+
+        std::cout << "produced " << producer_count
+                  << " objects on the right\n"
+                  << "consumed " << owner_count
+                  << " objects on the right\n"
+                  << "stole " << thief_count
+                  << " objects on the left in " << steals << " batches"
+                  << std::endl;
+    }
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "CAS-Based Lock-Free Algorithm for Shared Deques"
+//  by M. M. Michael
+//  Link: http://www.research.ibm.com/people/m/michael/europar-2003.pdf
+//
+//  C++ implementation - Copyright (C) 2011      Bryce Lelbach
+//  Test               - Copyright (C) 2026      agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+////////////////////////////////////////////////////////////////////////////////
+
+// Every thread performs a random sequence of pushes and pops on both ends and
+// injects random delays between (and yields inside) the operations, so that
+// each round explores a different schedule. Every value is pushed once and
+// has to be popped exactly once.
+
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/lockfree/deque.hpp>
+#include <boost/program_options.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+std::size_t rounds = 20;
+std::size_t operations = 20000;
+std::size_t thread_count = 4;
+
+struct stress_round
+{
+    boost::lockfree::deque<std::size_t> deque;
+    boost::scoped_array<boost::atomic<int> > popped;
+    boost::atomic<std::size_t> next_value;
+
+    stress_round():
+        popped(new boost::atomic<int>[thread_count * operations]),
+        next_value(0)
+    {
+        for (std::size_t i = 0; i != thread_count * operations; ++i)
+            popped[i].store(0);
+    }
+
+    // xorshift generator, each thread has its own state
+    static boost::uint32_t random(boost::uint32_t& state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    static void delay(boost::uint32_t& state)
+    {
+        boost::uint32_t r = random(state) % 64;
+        if (r == 0)
+            boost::this_thread::yield();
+        else
+            for (volatile boost::uint32_t i = 0; i != r; ++i) {}
+    }
+
+    void consume(std::size_t value)
+    {
+        HPX_TEST_LT(value, thread_count * operations);
+        HPX_TEST_EQ(++popped[value], 1);
+    }
+
+    void worker(boost::uint32_t seed)
+    {
+        boost::uint32_t state = seed | 1;
+        std::size_t batch[8];
+        std::size_t value(0);
+
+        for (std::size_t i = 0; i != operations; ++i) {
+            delay(state);
+
+            switch (random(state) % 5) {
+            case 0:
+                HPX_TEST(deque.push_left(next_value++));
+                break;
+            case 1:
+                HPX_TEST(deque.push_right(next_value++));
+                break;
+            case 2:
+                if (deque.pop_left(value))
+                    consume(value);
+                break;
+            case 3:
+                if (deque.pop_right(value))
+                    consume(value);
+                break;
+            case 4:
+                for (std::size_t j = 0, n = deque.steal_half(batch, 8);
+                     j != n; ++j)
+                    consume(batch[j]);
+                break;
+            }
+        }
+    }
+
+    void run(boost::uint32_t seed)
+    {
+        boost::thread_group threads;
+        for (std::size_t i = 0; i != thread_count; ++i)
+            threads.create_thread(boost::bind(&stress_round::worker, this,
+                seed * boost::uint32_t(thread_count + 1) + boost::uint32_t(i)));
+        threads.join_all();
+
+        std::size_t value(0);
+        while (deque.pop_left(value))
+            consume(value);
+        HPX_TEST(deque.empty());
+
+        for (std::size_t i = 0; i != next_value; ++i)
+            HPX_TEST_EQ(popped[i].load(), 1);
+    }
+};
+
+int main(int argc, char** argv)
+{
+    using boost::program_options::variables_map;
+    using boost::program_options::options_description;
+    using boost::program_options::value;
+    using boost::program_options::store;
+    using boost::program_options::command_line_parser;
+    using boost::program_options::notify;
+
+    variables_map vm;
+
+    options_description
+        desc_cmdline("Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_cmdline.add_options()
+        ("help,h", "print out program usage (this message)")
+        ("threads,t", value<std::size_t>(),
+         "the number of worker threads (default: 4)")
+        ("rounds,r", value<std::size_t>(),
+         "the number of rounds with different schedules (default: 20)")
+        ("operations,o", value<std::size_t>(),
+         "the number of operations per thread and round (default: 20000)")
+    ;
+
+    store(command_line_parser(argc, argv).options(desc_cmdline).run(), vm);
+
+    notify(vm);
+
+    // print help screen
+    if (vm.count("help"))
+    {
+        std::cout << desc_cmdline;
+        return hpx::util::report_errors();
+    }
+
+    if (vm.count("threads"))
+        thread_count = vm["threads"].as<std::size_t>();
+
+    if (vm.count("rounds"))
+        rounds = vm["rounds"].as<std::size_t>();
+
+    if (vm.count("operations"))
+        operations = vm["operations"].as<std::size_t>();
+
+    for (std::size_t r = 0; r != rounds; ++r) {
+        stress_round round;
+        round.run(boost::uint32_t(r + 1));
+    }
+
+    std::cout << "completed " << rounds << " rounds of " << operations
+              << " operations in " << thread_count << " threads" << std::endl;
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,127 @@
+#include <boost/lockfree/fan_in_channel.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( fan_in_channel_round_robin_test )
+{
+    fan_in_channel<int> f(3, 16);
+
+    size_t p0 = f.register_producer();
+    size_t p1 = f.register_producer();
+    size_t p2 = f.register_producer();
+    BOOST_REQUIRE_THROW(f.register_producer(), std::length_error);
+
+    BOOST_REQUIRE(f.empty());
+
+    for (int i = 0; i != 3; ++i) {
+        BOOST_REQUIRE(f.enqueue(p0, i));
+        BOOST_REQUIRE(f.enqueue(p2, 100 + i));
+    }
+    BOOST_REQUIRE(f.enqueue(p1, 50));
+
+    int expected[] = {0, 50, 100, 1, 101, 2, 102};
+    for (int i = 0; i != 7; ++i) {
+        int out;
+        BOOST_REQUIRE(f.dequeue(&out));
+        BOOST_REQUIRE_EQUAL(out, expected[i]);
+    }
+
+    int out;
+    BOOST_REQUIRE(!f.dequeue(&out));
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( fan_in_channel_zero_producers_test )
+{
+    BOOST_REQUIRE_THROW(fan_in_channel<int> f(0, 16), std::invalid_argument);
+    BOOST_REQUIRE_THROW((fan_in_channel<int, oldest_first>(0, 16)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( fan_in_channel_oldest_first_test )
+{
+    fan_in_channel<int, oldest_first> f(2, 16);
+
+    size_t p0 = f.register_producer();
+    size_t p1 = f.register_producer();
+
+    int out;
+    BOOST_REQUIRE(f.enqueue(p1, 10));
+    BOOST_REQUIRE(f.enqueue(p1, 11));
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 10);
+
+    /* enqueued after the first dequeue, so it is younger than 11 */
+    BOOST_REQUIRE(f.enqueue(p0, 0));
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 11);
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+
+    BOOST_REQUIRE(!f.dequeue(&out));
+    BOOST_REQUIRE(f.empty());
+}
+
+static const int nodes_per_thread = 100000;
+static const int producer_count = 4;
+
+template <typename Policy>
+struct fan_in_channel_tester
+{
+    fan_in_channel<int, Policy> channel;
+
+    fan_in_channel_tester(void):
+        channel(producer_count, 64)
+    {}
+
+    void add(void)
+    {
+        size_t producer = channel.register_producer();
+        for (int i = 0; i != nodes_per_thread; ++i)
+            while (!channel.enqueue(producer, int(producer) * nodes_per_thread + i))
+                boost::this_thread::yield();
+    }
+
+    void run(void)
+    {
+        thread_group writers;
+        for (int i = 0; i != producer_count; ++i)
+            writers.create_thread(boost::bind(&fan_in_channel_tester::add, this));
+
+        /* elements of each producer arrive in order */
+        vector<int> next(producer_count, 0);
+        for (int received = 0; received != producer_count * nodes_per_thread;) {
+            int data;
+            if (!channel.dequeue(&data)) {
+                boost::this_thread::yield();
+                continue;
+            }
+
+            int producer = data / nodes_per_thread;
+            BOOST_REQUIRE_EQUAL(data % nodes_per_thread, next[producer]);
+            ++next[producer];
+            ++received;
+        }
+
+        writers.join_all();
+        BOOST_REQUIRE(channel.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( fan_in_channel_test )
+{
+    fan_in_channel_tester<round_robin> test1;
+    test1.run();
+
+    fan_in_channel_tester<oldest_first> test2;
+    test2.run();
+}
@@ -1,4 +1,6 @@
 #include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/stack.hpp>
+#include <boost/lockfree/deque.hpp>
 
 #include <climits>
 #define BOOST_TEST_MODULE lockfree_tests
@@ -8,9 +10,10 @@
 #include <boost/thread.hpp>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 
-#include "test_helpers.hpp"
+#include "fifo_tester.hpp"
 
 using namespace boost;
 using namespace boost::lockfree;
@@ -38,6 +41,45 @@ BOOST_AUTO_TEST_CASE( simple_fifo_test )
 }
 
 
+template <typename fifo_type>
+void test_unsynchronized_fifo(fifo_type & f)
+{
+    BOOST_REQUIRE(f.unsynchronized_enqueue(0));
+
+    int in[63];
+    for (int i = 0; i != 63; ++i)
+        in[i] = i + 1;
+    BOOST_REQUIRE(f.unsynchronized_enqueue(in, in + 63) == in + 63);
+
+    /* the unsynchronized and the synchronized operations can be mixed */
+    int out;
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+    BOOST_REQUIRE(f.enqueue(64));
+
+    std::vector<int> drained;
+    BOOST_REQUIRE_EQUAL(f.unsynchronized_dequeue_all(std::back_inserter(drained)), 64u);
+    for (int i = 0; i != 64; ++i)
+        BOOST_REQUIRE_EQUAL(drained[i], i + 1);
+
+    BOOST_REQUIRE(!f.unsynchronized_dequeue(&out));
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( fifo_unsynchronized_test )
+{
+    fifo<int> f(16);
+    test_unsynchronized_fifo(f);
+
+    fifo<int, capacity<64> > fixed;
+    test_unsynchronized_fifo(fixed);
+
+    /* a range, which exceeds the capacity, is enqueued partially */
+    int in[128] = {0};
+    BOOST_REQUIRE(fixed.unsynchronized_enqueue(in, in + 128) == in + 64);
+}
+
+
 BOOST_AUTO_TEST_CASE( fifo_specialization_test )
 {
     fifo<int*> f;
@@ -80,114 +122,157 @@ BOOST_AUTO_TEST_CASE( fifo_specialization_test )
     BOOST_REQUIRE(f.empty());
 }
 
-template <typename freelist_t>
-struct fifo_tester
+BOOST_AUTO_TEST_CASE( fifo_try_sleep_test )
 {
-    fifo<int, freelist_t> sf;
+    fifo<int> f(64);
+    bool was_idle = true;
 
-    atomic<long> fifo_cnt, received_nodes;
+    /* a new fifo is not idle */
+    BOOST_REQUIRE(f.enqueue_notify(1, was_idle));
+    BOOST_REQUIRE(!was_idle);
 
-    static_hashed_set<int, 1<<16 > working_set;
+    BOOST_REQUIRE(!f.try_sleep());
 
-    static const uint nodes_per_thread = 200000/* 00 *//* 0 */;
+    int out;
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE(f.try_sleep());
+    BOOST_REQUIRE(f.try_sleep());
+    BOOST_REQUIRE(!f.dequeue(&out));
+    BOOST_REQUIRE(f.empty());
 
-    static const int reader_threads = 2;
-    static const int writer_threads = 2;
+    BOOST_REQUIRE(f.enqueue_notify(2, was_idle));
+    BOOST_REQUIRE(was_idle);
+    BOOST_REQUIRE(f.enqueue_notify(3, was_idle));
+    BOOST_REQUIRE(!was_idle);
 
-    fifo_tester(void):
-        fifo_cnt(0), received_nodes(0)
-    {}
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 2);
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 3);
 
-    void add(void)
-    {
-        for (uint i = 0; i != nodes_per_thread; ++i)
-        {
-            while(fifo_cnt > 10000)
-                thread::yield();
+    BOOST_REQUIRE(f.try_sleep());
+    BOOST_REQUIRE(f.enqueue(4));
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 4);
+}
 
-            int id = generate_id<int>();
+template <typename node, typename link>
+void test_node_tag_reuse(typename node::tag_t old_tag)
+{
+    typename boost::aligned_storage<sizeof(node), boost::alignment_of<node>::value>::type storage;
+
+    node * n = new(&storage) node();
+    typename node::tag_t tag = old_tag;
+    n->next.store(link(0, tag));
+    n->~node();
+
+    /* a reused node has to carry over the tag of its next pointer */
+    n = node::construct(n, 1);
+    BOOST_REQUIRE_EQUAL(n->next.load().get_tag(), old_tag + 1);
+    BOOST_REQUIRE_EQUAL(n->data, 1);
+    n->~node();
+}
 
-            working_set.insert(id);
+BOOST_AUTO_TEST_CASE( fifo_node_tag_test )
+{
+    typedef boost::lockfree::detail::fifo_node<int, padded_node_t> padded_node;
+    typedef boost::lockfree::detail::fifo_node<int, packed_node_t> packed_node;
+    typedef boost::lockfree::detail::select_tagged_index<16>::link_type tagged_index;
 
-            while (sf.enqueue(id) == false)
-            {
-                thread::yield();
-            }
+    test_node_tag_reuse<padded_node, padded_node::tagged_ptr_t>(41);
+    test_node_tag_reuse<packed_node, packed_node::tagged_ptr_t>(41);
+    test_node_tag_reuse<boost::lockfree::detail::fixed_fifo_node<int, tagged_index>, tagged_index>(41);
+}
 
-            ++fifo_cnt;
-        }
-    }
+BOOST_AUTO_TEST_CASE( fifo_shared_pool_test )
+{
+    fifo<int, shared_freelist_t>::pool_type pool(16);
 
-    bool get_element(void)
     {
-        int data;
-
-        bool success = sf.dequeue(&data);
-
-        if (success)
-        {
-            ++received_nodes;
-            --fifo_cnt;
-            bool erased = working_set.erase(data);
-            assert(erased);
-            return true;
+        /* fifos with the same node size share one pool */
+        fifo<int, shared_freelist_t> f1(pool);
+        fifo<float, shared_freelist_t> f2(pool);
+
+        for (int i = 0; i != 64; ++i)
+            BOOST_REQUIRE(f1.enqueue(i));
+        for (int i = 0; i != 64; ++i) {
+            int out;
+            BOOST_REQUIRE(f1.dequeue(&out));
+            BOOST_REQUIRE_EQUAL(out, i);
         }
-        else
-            return false;
-    }
 
-    volatile bool running;
-
-    void get(void)
-    {
-        for(;;)
-        {
-            bool success = get_element();
-            if (not running and not success)
-                return;
-            if (not success)
-                thread::yield();
-        }
+        /* nodes freed by f1 are reused by f2 */
+        for (int i = 0; i != 64; ++i)
+            BOOST_REQUIRE(f2.enqueue(float(i)));
+        float out;
+        BOOST_REQUIRE(f2.dequeue(&out));
+        BOOST_REQUIRE_EQUAL(out, 0.f);
     }
 
-    void run(void)
-    {
-        running = true;
-
-        thread_group writer;
-        thread_group reader;
-
-        BOOST_REQUIRE(sf.empty());
-        for (int i = 0; i != reader_threads; ++i)
-            reader.create_thread(boost::bind(&fifo_tester::get, this));
-
-        for (int i = 0; i != writer_threads; ++i)
-            writer.create_thread(boost::bind(&fifo_tester::add, this));
-        cout << "reader and writer threads created" << endl;
+    fifo<int, shared_freelist_t> f3(pool);
+    BOOST_REQUIRE(f3.enqueue(1));
+}
 
-        writer.join_all();
-        cout << "writer threads joined. waiting for readers to finish" << endl;
+BOOST_AUTO_TEST_CASE( fifo_stack_shared_pool_test )
+{
+    fifo<int, shared_freelist_t>::pool_type pool;
+
+    fifo<int, shared_freelist_t> f(pool);
+    boost::lockfree::stack<int, shared_freelist_t> s(pool);
+    boost::lockfree::deque<int, shared_freelist_t> d(pool);
+
+    /* the nodes of all three containers are drawn from the same pool */
+    for (int round = 0; round != 3; ++round) {
+        for (int i = 0; i != 64; ++i)
+            BOOST_REQUIRE(f.enqueue(i));
+        for (int i = 0; i != 64; ++i) {
+            int out;
+            BOOST_REQUIRE(f.dequeue(&out));
+            BOOST_REQUIRE_EQUAL(out, i);
+        }
 
-        running = false;
-        reader.join_all();
+        for (int i = 0; i != 64; ++i)
+            BOOST_REQUIRE(s.push(i));
+        for (int i = 63; i >= 0; --i) {
+            int out;
+            BOOST_REQUIRE(s.pop(&out));
+            BOOST_REQUIRE_EQUAL(out, i);
+        }
 
-        BOOST_REQUIRE_EQUAL(received_nodes, writer_threads * nodes_per_thread);
-        BOOST_REQUIRE_EQUAL(fifo_cnt, 0);
-        BOOST_REQUIRE(sf.empty());
-        BOOST_REQUIRE(working_set.count_nodes() == 0);
+        for (int i = 0; i != 64; ++i)
+            BOOST_REQUIRE(d.push_right(i));
+        for (int i = 0; i != 64; ++i) {
+            int out;
+            BOOST_REQUIRE(d.pop_left(out));
+            BOOST_REQUIRE_EQUAL(out, i);
+        }
     }
-};
-
 
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(s.empty());
+    BOOST_REQUIRE(d.empty());
+}
 
 BOOST_AUTO_TEST_CASE( fifo_test_caching )
 {
-    fifo_tester<boost::lockfree::caching_freelist_t> test1;
+    fifo_tester<fifo<int, caching_freelist_t> > test1;
     test1.run();
 }
 
 BOOST_AUTO_TEST_CASE( fifo_test_static )
 {
-    fifo_tester<boost::lockfree::static_freelist_t> test1;
+    fifo_tester<fifo<int, static_freelist_t> > test1;
+    test1.run();
+}
+
+BOOST_AUTO_TEST_CASE( fifo_test_packed )
+{
+    fifo_tester<fifo<int, caching_freelist_t, std::allocator<int>, packed_node_t> > test1;
+    test1.run();
+}
+
+BOOST_AUTO_TEST_CASE( fifo_test_inline_storage )
+{
+    fifo_tester<fifo<int, capacity<1024> > > test1;
     test1.run();
 }
@@ -0,0 +1,107 @@
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <iostream>
+
+#include "test_helpers.hpp"
+
+/* stress test for multi-writer/multi-reader fifos: fifo_type has to be default-constructible and provide enqueue,
+ * dequeue and empty */
+template <typename fifo_type>
+struct fifo_tester
+{
+    fifo_type sf;
+
+    boost::atomic<long> fifo_cnt, received_nodes;
+
+    static_hashed_set<int, 1<<16 > working_set;
+
+    static const unsigned int nodes_per_thread = 200000/* 00 *//* 0 */;
+
+    static const int reader_threads = 2;
+    static const int writer_threads = 2;
+
+    fifo_tester(void):
+        fifo_cnt(0), received_nodes(0)
+    {}
+
+    void add(void)
+    {
+        for (unsigned int i = 0; i != nodes_per_thread; ++i)
+        {
+            while(fifo_cnt > 10000)
+                boost::thread::yield();
+
+            int id = generate_id<int>();
+
+            working_set.insert(id);
+
+            while (sf.enqueue(id) == false)
+            {
+                boost::thread::yield();
+            }
+
+            ++fifo_cnt;
+        }
+    }
+
+    bool get_element(void)
+    {
+        int data;
+
+        bool success = sf.dequeue(&data);
+
+        if (success)
+        {
+            ++received_nodes;
+            --fifo_cnt;
+            bool erased = working_set.erase(data);
+            assert(erased);
+            return true;
+        }
+        else
+            return false;
+    }
+
+    volatile bool running;
+
+    void get(void)
+    {
+        for(;;)
+        {
+            bool still_running = running;
+            bool success = get_element();
+            if (not still_running and not success)
+                return;
+            if (not success)
+                boost::thread::yield();
+        }
+    }
+
+    void run(void)
+    {
+        running = true;
+
+        boost::thread_group writer;
+        boost::thread_group reader;
+
+        BOOST_REQUIRE(sf.empty());
+        for (int i = 0; i != reader_threads; ++i)
+            reader.create_thread(boost::bind(&fifo_tester::get, this));
+
+        for (int i = 0; i != writer_threads; ++i)
+            writer.create_thread(boost::bind(&fifo_tester::add, this));
+        std::cout << "reader and writer threads created" << std::endl;
+
+        writer.join_all();
+        std::cout << "writer threads joined. waiting for readers to finish" << std::endl;
+
+        running = false;
+        reader.join_all();
+
+        BOOST_REQUIRE_EQUAL(received_nodes, writer_threads * nodes_per_thread);
+        BOOST_REQUIRE_EQUAL(fifo_cnt, 0);
+        BOOST_REQUIRE(sf.empty());
+        BOOST_REQUIRE(working_set.count_nodes() == 0);
+    }
+};
@@ -0,0 +1,87 @@
+//  Copyright (C) 2026 agent
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+// Built without -mcx16 (see Jamfile.v2): the anchor and the node links of an
+// indexed deque have to be lock-free with single-width CAS.
+
+#include <boost/lockfree/deque.hpp>
+
+#include <stdexcept>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+typedef lockfree::deque<int, indexed_freelist_t> indexed_deque;
+typedef lockfree::deque<int, indexed_freelist_t, capacity<1000> > small_deque;
+typedef lockfree::deque<int, indexed_freelist_t, capacity<100000> > large_deque;
+
+BOOST_STATIC_ASSERT(sizeof(indexed_deque::node_pointer) <= sizeof(boost::uint64_t));
+BOOST_STATIC_ASSERT(sizeof(small_deque::node_pointer) <= sizeof(boost::uint64_t));
+BOOST_STATIC_ASSERT(sizeof(large_deque::node_pointer) <= sizeof(boost::uint64_t));
+
+// 16-bit indices by default, narrower indices leave more bits for the tag
+BOOST_STATIC_ASSERT(indexed_deque::anchor::tag_bits == 30);
+BOOST_STATIC_ASSERT(small_deque::anchor::tag_bits == 42);
+BOOST_STATIC_ASSERT(large_deque::anchor::tag_bits == 28);
+
+template <typename deque_type>
+void check_push_pop(deque_type& d)
+{
+    BOOST_REQUIRE(d.is_lock_free());
+    BOOST_REQUIRE(d.empty());
+
+    for (int i = 0; i != 10; ++i)
+        BOOST_REQUIRE(d.push_right(i));
+    BOOST_REQUIRE(d.push_left(-1));
+
+    int out = 0;
+    BOOST_REQUIRE(d.pop_left(out));
+    BOOST_REQUIRE_EQUAL(out, -1);
+    BOOST_REQUIRE(d.pop_right(out));
+    BOOST_REQUIRE_EQUAL(out, 9);
+
+    int stolen[5];
+    BOOST_REQUIRE_EQUAL(d.steal_half(stolen, 5), 5U);
+    for (int i = 0; i != 5; ++i)
+        BOOST_REQUIRE_EQUAL(stolen[i], i);
+
+    for (int i = 5; i != 9; ++i)
+    {
+        BOOST_REQUIRE(d.pop_left(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!d.pop_left(out));
+    BOOST_REQUIRE(d.empty());
+}
+
+BOOST_AUTO_TEST_CASE( indexed_deque_lock_free_test )
+{
+    indexed_deque d(64);
+    check_push_pop(d);
+
+    small_deque s;
+    check_push_pop(s);
+
+    large_deque l;
+    check_push_pop(l);
+}
+
+BOOST_AUTO_TEST_CASE( indexed_deque_capacity_test )
+{
+    small_deque d;
+    int i = 0;
+    while (d.push_right(i))
+        ++i;
+    BOOST_REQUIRE_EQUAL(i, 1000);
+
+    BOOST_REQUIRE_THROW(indexed_deque(std::size_t(1) << 16), std::length_error);
+}
@@ -0,0 +1,130 @@
+#include <boost/lockfree/lossy_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <iostream>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( simple_lossy_ringbuffer_test )
+{
+    lossy_ringbuffer<int, 64> f;
+
+    BOOST_REQUIRE(f.empty());
+    f.enqueue(1);
+    f.enqueue(2);
+
+    int i1(0), i2(0);
+    size_t lost = 1;
+
+    BOOST_REQUIRE(f.dequeue(&i1, &lost));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+    BOOST_REQUIRE_EQUAL(lost, 0u);
+
+    BOOST_REQUIRE(f.dequeue(&i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(!f.dequeue(&i1, &lost));
+    BOOST_REQUIRE_EQUAL(lost, 0u);
+}
+
+BOOST_AUTO_TEST_CASE( lossy_ringbuffer_overrun_test )
+{
+    lossy_ringbuffer<int, 0> f(4);
+
+    for (int i = 0; i != 10; ++i)
+        f.enqueue(i);
+
+    int out;
+    size_t lost;
+
+    /* the slot of the oldest element is the next one to be overwritten, so it is skipped as well */
+    BOOST_REQUIRE(f.dequeue(&out, &lost));
+    BOOST_REQUIRE_EQUAL(out, 7);
+    BOOST_REQUIRE_EQUAL(lost, 7u);
+
+    BOOST_REQUIRE(f.dequeue(&out, &lost));
+    BOOST_REQUIRE_EQUAL(out, 8);
+    BOOST_REQUIRE_EQUAL(lost, 0u);
+
+    f.enqueue(10);
+
+    BOOST_REQUIRE(f.dequeue(&out, &lost));
+    BOOST_REQUIRE_EQUAL(out, 9);
+    BOOST_REQUIRE(f.dequeue(&out, &lost));
+    BOOST_REQUIRE_EQUAL(out, 10);
+    BOOST_REQUIRE(!f.dequeue(&out, &lost));
+}
+
+static const int nodes_per_thread = 2000000;
+
+struct lossy_ringbuffer_tester
+{
+    lossy_ringbuffer<int, 0> sf;
+
+    boost::atomic<bool> running;
+    size_t received_nodes;
+    size_t lost_nodes;
+
+    lossy_ringbuffer_tester(void):
+        sf(128), running(true), received_nodes(0), lost_nodes(0)
+    {}
+
+    void add(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i)
+            sf.enqueue(i);
+    }
+
+    bool get_element(int & last)
+    {
+        int data;
+        size_t lost;
+        bool success = sf.dequeue(&data, &lost);
+        lost_nodes += lost;
+
+        if (success) {
+            BOOST_REQUIRE_EQUAL(data, last + 1 + int(lost));
+            last = data;
+            ++received_nodes;
+        }
+        return success;
+    }
+
+    void get(void)
+    {
+        int last = -1;
+        for(;;) {
+            bool still_running = running.load();
+            bool success = get_element(last);
+            if (!still_running && !success)
+                return;
+        }
+    }
+
+    void run(void)
+    {
+        thread reader(boost::bind(&lossy_ringbuffer_tester::get, this));
+        thread writer(boost::bind(&lossy_ringbuffer_tester::add, this));
+
+        writer.join();
+        running = false;
+        reader.join();
+
+        cout << "received: " << received_nodes << ", lost: " << lost_nodes << endl;
+        BOOST_REQUIRE_EQUAL(received_nodes + lost_nodes, size_t(nodes_per_thread));
+        BOOST_REQUIRE(sf.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( lossy_ringbuffer_test )
+{
+    lossy_ringbuffer_tester test1;
+    test1.run();
+}
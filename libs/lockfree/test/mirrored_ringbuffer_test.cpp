@@ -0,0 +1,120 @@
+#include <boost/lockfree/mirrored_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <cstring>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( simple_mirrored_ringbuffer_test )
+{
+    mirrored_ringbuffer<int> f(64);
+
+    BOOST_REQUIRE(f.max_size() >= 64);
+    BOOST_REQUIRE(f.empty());
+    f.enqueue(1);
+    f.enqueue(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.dequeue(&i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.dequeue(&i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mirrored_ringbuffer_wraparound_test )
+{
+    mirrored_ringbuffer<char> f(1);
+    const size_t size = f.max_size();
+
+    vector<char> data(size - 1), out(size - 1);
+    for (size_t i = 0; i != data.size(); ++i)
+        data[i] = char(i * 7);
+
+    /* move the indices to the middle of the buffer, so that the next window wraps around */
+    for (size_t i = 0; i != size / 2; ++i) {
+        char c;
+        BOOST_REQUIRE(f.enqueue('x'));
+        BOOST_REQUIRE(f.dequeue(&c));
+    }
+
+    size_t available;
+    char * window = f.prepare_write(available);
+    BOOST_REQUIRE_EQUAL(available, size - 1);
+    std::memcpy(window, &data.front(), data.size());
+    f.commit_write(data.size());
+
+    char const * readable = f.prepare_read(available);
+    BOOST_REQUIRE_EQUAL(available, size - 1);
+    BOOST_REQUIRE(std::memcmp(readable, &data.front(), data.size()) == 0);
+    f.commit_read(available);
+    BOOST_REQUIRE(f.empty());
+
+    BOOST_REQUIRE_EQUAL(f.enqueue(&data.front(), data.size()), data.size());
+    BOOST_REQUIRE_EQUAL(f.dequeue(&out.front(), out.size()), out.size());
+    BOOST_REQUIRE(data == out);
+}
+
+static const unsigned int nodes_per_thread = 500000;
+
+struct mirrored_ringbuffer_tester
+{
+    mirrored_ringbuffer<unsigned int> sf;
+    unsigned int received_nodes;
+
+    mirrored_ringbuffer_tester(void):
+        sf(1), received_nodes(0)
+    {}
+
+    void add(void)
+    {
+        unsigned int next = 0;
+        while (next != nodes_per_thread) {
+            size_t available;
+            unsigned int * window = sf.prepare_write(available);
+            available = std::min<size_t>(available, nodes_per_thread - next);
+            for (size_t i = 0; i != available; ++i)
+                window[i] = next++;
+            sf.commit_write(available);
+        }
+    }
+
+    void get(void)
+    {
+        while (received_nodes != nodes_per_thread) {
+            size_t available;
+            unsigned int const * window = sf.prepare_read(available);
+            for (size_t i = 0; i != available; ++i)
+                BOOST_REQUIRE_EQUAL(window[i], received_nodes++);
+            sf.commit_read(available);
+        }
+    }
+
+    void run(void)
+    {
+        thread reader(boost::bind(&mirrored_ringbuffer_tester::get, this));
+        thread writer(boost::bind(&mirrored_ringbuffer_tester::add, this));
+
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE_EQUAL(received_nodes, nodes_per_thread);
+        BOOST_REQUIRE(sf.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( mirrored_ringbuffer_zero_copy_test )
+{
+    mirrored_ringbuffer_tester test1;
+    test1.run();
+}
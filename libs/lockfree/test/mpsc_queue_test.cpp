@@ -0,0 +1,185 @@
+#include <boost/lockfree/mpsc_queue.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/thread.hpp>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+struct message:
+    mpsc_queue_hook
+{
+    int producer;
+    int id;
+};
+
+BOOST_AUTO_TEST_CASE( simple_mpsc_queue_test )
+{
+    mpsc_queue<message> f;
+    message m1, m2;
+    m1.id = 1;
+    m2.id = 2;
+
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(!f.dequeue());
+
+    f.enqueue(&m1);
+    f.enqueue(&m2);
+    BOOST_REQUIRE(!f.empty());
+
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m1);
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m2);
+    BOOST_REQUIRE(!f.dequeue());
+    BOOST_REQUIRE(f.empty());
+
+    /* elements can be reused after they have been dequeued */
+    f.enqueue(&m2);
+    f.enqueue(&m1);
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m2);
+    BOOST_REQUIRE(!f.empty());
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m1);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_try_sleep_test )
+{
+    mpsc_queue<message> f;
+    message m1, m2;
+
+    /* a new queue is not idle */
+    BOOST_REQUIRE(!f.enqueue_notify(&m1));
+    BOOST_REQUIRE(!f.try_sleep());
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m1);
+
+    BOOST_REQUIRE(f.try_sleep());
+    BOOST_REQUIRE(f.try_sleep());
+    BOOST_REQUIRE(!f.dequeue());
+    BOOST_REQUIRE(f.empty());
+
+    BOOST_REQUIRE(f.enqueue_notify(&m1));
+    BOOST_REQUIRE(!f.enqueue_notify(&m2));
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m1);
+    BOOST_REQUIRE(!f.try_sleep());
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m2);
+    BOOST_REQUIRE(f.try_sleep());
+
+    f.enqueue(&m1);
+    BOOST_REQUIRE_EQUAL(f.dequeue(), &m1);
+}
+
+static const int nodes_per_thread = 100000;
+static const int producer_count = 4;
+
+struct mpsc_queue_tester
+{
+    mpsc_queue<message> q;
+    vector<message> messages;
+
+    mpsc_queue_tester(void):
+        messages(producer_count * nodes_per_thread)
+    {}
+
+    void add(int producer)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            message & m = messages[producer * nodes_per_thread + i];
+            m.producer = producer;
+            m.id = i;
+            q.enqueue(&m);
+        }
+    }
+
+    void run(void)
+    {
+        thread_group writers;
+        for (int i = 0; i != producer_count; ++i)
+            writers.create_thread(boost::bind(&mpsc_queue_tester::add, this, i));
+
+        vector<int> next(producer_count, 0);
+        for (int received = 0; received != producer_count * nodes_per_thread;) {
+            message * m = q.dequeue();
+            if (!m) {
+                boost::this_thread::yield();
+                continue;
+            }
+
+            BOOST_REQUIRE_EQUAL(m->id, next[m->producer]);
+            ++next[m->producer];
+            ++received;
+        }
+
+        writers.join_all();
+        BOOST_REQUIRE(q.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_test )
+{
+    mpsc_queue_tester test1;
+    test1.run();
+}
+
+/* the consumer only runs after a producer has observed the transition to the non-empty state, a lost wakeup would
+ * stall the test */
+struct mpsc_queue_scheduling_tester:
+    mpsc_queue_tester
+{
+    boost::atomic<int> wakeups;
+
+    mpsc_queue_scheduling_tester(void):
+        wakeups(0)
+    {}
+
+    void add(int producer)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            message & m = messages[producer * nodes_per_thread + i];
+            m.producer = producer;
+            m.id = i;
+            if (q.enqueue_notify(&m))
+                ++wakeups;
+        }
+    }
+
+    void run(void)
+    {
+        BOOST_REQUIRE(q.try_sleep());
+
+        thread_group writers;
+        for (int i = 0; i != producer_count; ++i)
+            writers.create_thread(boost::bind(&mpsc_queue_scheduling_tester::add, this, i));
+
+        int received = 0, sleeps = 1;
+        while (received != producer_count * nodes_per_thread) {
+            while (wakeups.load() != sleeps)
+                boost::this_thread::yield();
+
+            for (;;) {
+                message * m = q.dequeue();
+                if (m) {
+                    ++received;
+                    continue;
+                }
+
+                if (q.try_sleep()) {
+                    ++sleeps;
+                    break;
+                }
+            }
+        }
+
+        writers.join_all();
+        BOOST_REQUIRE(q.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( mpsc_queue_scheduling_test )
+{
+    mpsc_queue_scheduling_tester test1;
+    test1.run();
+}
@@ -0,0 +1,147 @@
+#include <boost/lockfree/pipeline.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( simple_pipeline_test )
+{
+    pipeline<int, 4> p;
+    size_t first = p.add_stage();
+    size_t second = p.add_stage(first);
+
+    BOOST_REQUIRE_EQUAL(p.stages(), 2u);
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(p.enqueue(i));
+    BOOST_REQUIRE(!p.enqueue(4)); /* full */
+
+    /* the second stage waits for the first one */
+    BOOST_REQUIRE(!p.front(second));
+
+    int * element = p.front(first);
+    BOOST_REQUIRE(element);
+    BOOST_REQUIRE_EQUAL(*element, 0);
+    *element = 10;
+    p.commit(first);
+
+    /* the producer waits for the final stage */
+    BOOST_REQUIRE(!p.enqueue(4));
+
+    element = p.front(second);
+    BOOST_REQUIRE(element);
+    BOOST_REQUIRE_EQUAL(*element, 10);
+    BOOST_REQUIRE(!p.empty(second));
+    p.commit(second);
+
+    BOOST_REQUIRE(p.enqueue(4));
+}
+
+BOOST_AUTO_TEST_CASE( pipeline_diamond_test )
+{
+    pipeline<int, 0> p(8);
+    size_t left = p.add_stage();
+    size_t right = p.add_stage();
+    size_t dependencies[] = {left, right};
+    size_t join = p.add_stage(dependencies, 2);
+
+    int * slot = p.claim();
+    BOOST_REQUIRE(slot);
+    *slot = 1;
+    BOOST_REQUIRE(!p.front(left)); /* not published, yet */
+    p.publish();
+
+    BOOST_REQUIRE(p.front(left));
+    p.commit(left);
+    BOOST_REQUIRE(!p.front(join));
+
+    BOOST_REQUIRE(p.front(right));
+    p.commit(right);
+
+    BOOST_REQUIRE(p.front(join));
+    p.commit(join);
+    BOOST_REQUIRE(p.empty(join));
+}
+
+static const int nodes_per_thread = 100000;
+
+struct pipeline_tester
+{
+    pipeline<int, 0> p;
+    size_t decode, enrich, publish;
+
+    pipeline_tester(void):
+        p(64)
+    {
+        decode = p.add_stage();
+        enrich = p.add_stage(decode);
+        publish = p.add_stage(enrich);
+    }
+
+    void add(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i)
+            while (!p.enqueue(i))
+                boost::this_thread::yield();
+    }
+
+    int * next(size_t stage)
+    {
+        int * element;
+        while (!(element = p.front(stage)))
+            boost::this_thread::yield();
+        return element;
+    }
+
+    void decode_stage(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            *next(decode) *= 2;
+            p.commit(decode);
+        }
+    }
+
+    void enrich_stage(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            *next(enrich) += 1;
+            p.commit(enrich);
+        }
+    }
+
+    void publish_stage(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            BOOST_REQUIRE_EQUAL(*next(publish), 2 * i + 1);
+            p.commit(publish);
+        }
+    }
+
+    void run(void)
+    {
+        thread t1(boost::bind(&pipeline_tester::decode_stage, this));
+        thread t2(boost::bind(&pipeline_tester::enrich_stage, this));
+        thread t3(boost::bind(&pipeline_tester::publish_stage, this));
+        thread writer(boost::bind(&pipeline_tester::add, this));
+
+        writer.join();
+        t1.join();
+        t2.join();
+        t3.join();
+
+        BOOST_REQUIRE(p.empty(publish));
+    }
+};
+
+BOOST_AUTO_TEST_CASE( pipeline_test )
+{
+    pipeline_tester test1;
+    test1.run();
+}
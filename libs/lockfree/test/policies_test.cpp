@@ -0,0 +1,142 @@
+#include <boost/lockfree/fifo.hpp>
+#include <boost/lockfree/stack.hpp>
+#include <boost/lockfree/work_stealing_deque.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+typedef lockfree::detail::container_policies<int> default_policies;
+BOOST_STATIC_ASSERT((boost::is_same<default_policies::freelist_t, caching_freelist_t>::value));
+BOOST_STATIC_ASSERT((boost::is_same<default_policies::allocator_t, std::allocator<int> >::value));
+BOOST_STATIC_ASSERT((boost::is_same<default_policies::backoff_t, no_backoff>::value));
+BOOST_STATIC_ASSERT((boost::is_same<default_policies::node_layout_t, padded_node_t>::value));
+BOOST_STATIC_ASSERT(!default_policies::has_capacity);
+
+/* positional arguments */
+typedef lockfree::detail::container_policies<int, static_freelist_t, std::allocator<char>, packed_node_t> positional_policies;
+BOOST_STATIC_ASSERT((boost::is_same<positional_policies::freelist_t, static_freelist_t>::value));
+BOOST_STATIC_ASSERT((boost::is_same<positional_policies::allocator_t, std::allocator<char> >::value));
+BOOST_STATIC_ASSERT((boost::is_same<positional_policies::node_layout_t, packed_node_t>::value));
+
+/* named arguments in any order, capacity implies a fixed-sized freelist */
+typedef lockfree::detail::container_policies<int, backoff<exponential_backoff<> >, capacity<16>,
+                                   lockfree::allocator<std::allocator<char> > > named_policies;
+BOOST_STATIC_ASSERT((boost::is_same<named_policies::freelist_t, static_freelist_t>::value));
+BOOST_STATIC_ASSERT((boost::is_same<named_policies::allocator_t, std::allocator<char> >::value));
+BOOST_STATIC_ASSERT((boost::is_same<named_policies::backoff_t, exponential_backoff<> >::value));
+BOOST_STATIC_ASSERT(named_policies::capacity == 16);
+
+typedef lockfree::detail::container_policies<int, capacity<16>, fixed_sized<false> > growable_policies;
+BOOST_STATIC_ASSERT((boost::is_same<growable_policies::freelist_t, caching_freelist_t>::value));
+
+
+BOOST_AUTO_TEST_CASE( fifo_capacity_test )
+{
+    fifo<int, capacity<16> > f;
+
+    for (int i = 0; i != 16; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+    BOOST_REQUIRE(!f.enqueue(16));
+
+    int out;
+    for (int i = 0; i != 16; ++i) {
+        BOOST_REQUIRE(f.dequeue(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!f.dequeue(&out));
+}
+
+BOOST_AUTO_TEST_CASE( fifo_named_policies_test )
+{
+    fifo<int, packed_node_t, backoff<exponential_backoff<2, 8> >, fixed_sized<false> > f(1);
+
+    for (int i = 0; i != 64; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+
+    int out;
+    for (int i = 0; i != 64; ++i) {
+        BOOST_REQUIRE(f.dequeue(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( stack_capacity_test )
+{
+    stack<int, capacity<4>, backoff<exponential_backoff<> > > s;
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(s.push(i));
+    BOOST_REQUIRE(!s.push(4));
+
+    int out;
+    for (int i = 3; i != -1; --i) {
+        BOOST_REQUIRE(s.pop(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(!s.pop(&out));
+}
+
+BOOST_AUTO_TEST_CASE( work_stealing_deque_capacity_test )
+{
+    work_stealing_deque<int, capacity<4> > d;
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(d.push_bottom(i));
+    BOOST_REQUIRE(!d.push_bottom(4));
+
+    int out;
+    BOOST_REQUIRE(d.steal(out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+}
+
+/* containers with a compile-time capacity and a fixed-sized freelist store their nodes inline */
+BOOST_STATIC_ASSERT((boost::is_base_of<lockfree::detail::fixed_fifo<int, 16, no_backoff>,
+                                       fifo<int, capacity<16> > >::value));
+BOOST_STATIC_ASSERT((boost::is_base_of<lockfree::detail::fixed_stack<int, 16, no_backoff>,
+                                       stack<int, capacity<16> > >::value));
+BOOST_STATIC_ASSERT((!boost::is_base_of<lockfree::detail::fixed_stack<int, 16, no_backoff>,
+                                        stack<int, capacity<16>, fixed_sized<false> > >::value));
+
+/* fifo nodes of up to 65533 elements are linked by a 16bit index with a 16bit tag */
+BOOST_STATIC_ASSERT(sizeof(lockfree::detail::select_tagged_index<17>::link_type) == 4);
+BOOST_STATIC_ASSERT(sizeof(lockfree::detail::fixed_fifo_node<int, lockfree::detail::select_tagged_index<17>::link_type>)
+                    == 8);
+BOOST_STATIC_ASSERT(sizeof(lockfree::detail::select_tagged_index<70001>::link_type) == 8);
+
+BOOST_AUTO_TEST_CASE( inline_storage_test )
+{
+    BOOST_REQUIRE(sizeof(fifo<int, capacity<16> >) > 17 * sizeof(int));
+    BOOST_REQUIRE(sizeof(stack<int, capacity<16> >) > 16 * sizeof(int));
+
+    stack<int, capacity<70000> > s;
+    for (int i = 0; i != 70000; ++i)
+        BOOST_REQUIRE(s.push(i));
+    BOOST_REQUIRE(!s.push(70000));
+
+    int out;
+    for (int i = 69999; i != -1; --i) {
+        BOOST_REQUIRE(s.pop(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(s.empty());
+
+    fifo<int, capacity<70000> > f;
+    for (int i = 0; i != 70000; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+    BOOST_REQUIRE(!f.enqueue(70000));
+
+    for (int i = 0; i != 70000; ++i) {
+        BOOST_REQUIRE(f.dequeue(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(f.empty());
+}
@@ -1,3 +1,4 @@
+#define BOOST_LOCKFREE_STREAMING_COPY_STATISTICS
 #include <boost/lockfree/ringbuffer.hpp>
 
 #include <climits>
@@ -8,6 +9,7 @@
 #include <boost/thread.hpp>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 
 #include "test_helpers.hpp"
@@ -96,7 +98,7 @@ struct ringbuffer_tester
 {
     ringbuffer<int, 128> sf;
 
-    atomic<long> ringbuffer_cnt, received_nodes;
+    boost::atomic<long> ringbuffer_cnt, received_nodes;
 
     static_hashed_set<int, 1<<16 > working_set;
 
@@ -182,10 +184,10 @@ struct ringbuffer_tester_buffering
 {
     ringbuffer<int, 128> sf;
 
-    atomic<long> ringbuffer_cnt;
+    boost::atomic<long> ringbuffer_cnt;
 
     static_hashed_set<int, 1<<16 > working_set;
-    atomic<long> received_nodes;
+    boost::atomic<long> received_nodes;
 
     ringbuffer_tester_buffering(void):
         ringbuffer_cnt(0), received_nodes(0)
@@ -279,3 +281,137 @@ BOOST_AUTO_TEST_CASE( ringbuffer_test_buffering )
     ringbuffer_tester_buffering test1;
     test1.run();
 }
+
+BOOST_AUTO_TEST_CASE( batched_ringbuffer_test )
+{
+    ringbuffer<int, 16> f;
+
+    {
+        batched_producer<ringbuffer<int, 16> > producer(f, 4);
+
+        for (int i = 0; i != 3; ++i)
+            BOOST_REQUIRE(producer.enqueue(i));
+        BOOST_REQUIRE(f.empty()); /* not yet published */
+
+        BOOST_REQUIRE(producer.enqueue(3));
+        BOOST_REQUIRE(!f.empty());
+
+        for (int i = 4; i != 15; ++i)
+            BOOST_REQUIRE(producer.enqueue(i));
+        BOOST_REQUIRE(!producer.enqueue(15)); /* full, publishes everything */
+    }
+
+    batched_consumer<ringbuffer<int, 16> > consumer(f, 4);
+    for (int i = 0; i != 15; ++i) {
+        int out;
+        BOOST_REQUIRE(consumer.dequeue(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+
+    int out;
+    BOOST_REQUIRE(!consumer.dequeue(&out));
+    BOOST_REQUIRE(f.empty());
+}
+
+struct ringbuffer_tester_batched
+{
+    typedef ringbuffer<int, 0> ringbuffer_type;
+    ringbuffer_type sf;
+    int received_nodes;
+
+    ringbuffer_tester_batched(void):
+        sf(128), received_nodes(0)
+    {}
+
+    void add(void)
+    {
+        batched_producer<ringbuffer_type> producer(sf, 16);
+        for (uint i = 0; i != nodes_per_thread; ++i)
+            while (!producer.enqueue(i))
+            {}
+    }
+
+    void get(void)
+    {
+        batched_consumer<ringbuffer_type> consumer(sf, 16);
+        while (uint(received_nodes) != nodes_per_thread) {
+            int data;
+            if (consumer.dequeue(&data)) {
+                BOOST_REQUIRE_EQUAL(data, received_nodes);
+                ++received_nodes;
+            }
+        }
+    }
+
+    void run(void)
+    {
+        thread reader(boost::bind(&ringbuffer_tester_batched::get, this));
+        thread writer(boost::bind(&ringbuffer_tester_batched::add, this));
+
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE(sf.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( ringbuffer_test_batched )
+{
+    ringbuffer_tester_batched test1;
+    test1.run();
+}
+
+BOOST_AUTO_TEST_CASE( ringbuffer_large_transfer_test )
+{
+    /* transfers above BOOST_LOCKFREE_STREAMING_COPY_THRESHOLD take the non-temporal copy path */
+    const size_t ringbuffer_size = 1 << 15;
+    const size_t transfer_size = 3 * ringbuffer_size / 4 + 3;
+
+    ringbuffer<int, 0> f(ringbuffer_size);
+    std::vector<int> data(transfer_size), out(transfer_size);
+
+    for (int round = 0; round != 4; ++round) {
+        for (size_t i = 0; i != transfer_size; ++i)
+            data[i] = int(i) * (round + 1);
+
+        BOOST_REQUIRE_EQUAL(f.enqueue(&data.front() + 1, transfer_size - 1), transfer_size - 1);
+        BOOST_REQUIRE_EQUAL(f.dequeue(&out.front() + 1, transfer_size - 1), transfer_size - 1);
+
+        for (size_t i = 1; i != transfer_size; ++i)
+            BOOST_REQUIRE_EQUAL(data[i], out[i]);
+        BOOST_REQUIRE(f.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ringbuffer_wrapped_streaming_test )
+{
+    /* a 30 KiB transfer wraps around as 14 KiB + 16 KiB: both sections take the path of the whole transfer */
+    const size_t ringbuffer_size = 32768 / sizeof(int);
+    const size_t first_section = 14336 / sizeof(int);
+    const size_t transfer_size = 30720 / sizeof(int);
+
+    ringbuffer<int, 0> f(ringbuffer_size);
+    std::vector<int> data(transfer_size), out(transfer_size);
+
+    /* move the indices, so that the next transfer wraps after first_section elements */
+    BOOST_REQUIRE_EQUAL(f.enqueue(&data.front(), ringbuffer_size - first_section), ringbuffer_size - first_section);
+    BOOST_REQUIRE_EQUAL(f.dequeue(&out.front(), ringbuffer_size - first_section), ringbuffer_size - first_section);
+
+    for (size_t i = 0; i != transfer_size; ++i)
+        data[i] = int(i);
+
+    const size_t sections = boost::lockfree::detail::streaming_copy_sections();
+    BOOST_REQUIRE_EQUAL(f.enqueue(&data.front(), transfer_size), transfer_size);
+
+#ifdef BOOST_LOCKFREE_HAVE_STREAMING_COPY
+    if (boost::lockfree::detail::streaming_copy_support() != boost::lockfree::detail::isa_none)
+        BOOST_REQUIRE_EQUAL(boost::lockfree::detail::streaming_copy_sections(), sections + 2);
+    else
+#endif
+        BOOST_REQUIRE_EQUAL(boost::lockfree::detail::streaming_copy_sections(), sections);
+
+    BOOST_REQUIRE_EQUAL(f.dequeue(&out.front(), transfer_size), transfer_size);
+    for (size_t i = 0; i != transfer_size; ++i)
+        BOOST_REQUIRE_EQUAL(data[i], out[i]);
+    BOOST_REQUIRE(f.empty());
+}
@@ -0,0 +1,162 @@
+#include <boost/lockfree/shm_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+static string segment_name(const char * suffix)
+{
+    char buffer[64];
+    std::sprintf(buffer, "/boost_lockfree_%d_%s", int(::getpid()), suffix);
+    return buffer;
+}
+
+BOOST_AUTO_TEST_CASE( shm_ringbuffer_attach_test )
+{
+    string name = segment_name("attach");
+    shm_ringbuffer<int>::remove(name.c_str());
+
+    shm_ringbuffer<int> producer(name.c_str(), 64);
+    shm_ringbuffer<int> consumer(name.c_str());
+
+    BOOST_WARN(producer.is_lock_free());
+    BOOST_REQUIRE(consumer.empty());
+
+    BOOST_REQUIRE(producer.enqueue(1));
+    BOOST_REQUIRE(producer.enqueue(2));
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(consumer.dequeue(&i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(consumer.dequeue(&i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(consumer.empty());
+    BOOST_REQUIRE(producer.empty());
+}
+
+BOOST_AUTO_TEST_CASE( shm_ringbuffer_layout_test )
+{
+    string name = segment_name("layout");
+    shm_ringbuffer<int>::remove(name.c_str());
+
+    BOOST_REQUIRE_THROW(shm_ringbuffer<int> missing(name.c_str()), boost::system::system_error);
+
+    shm_ringbuffer<int> producer(name.c_str(), 64);
+
+    BOOST_REQUIRE_THROW(shm_ringbuffer<int> duplicate(name.c_str(), 64), boost::system::system_error);
+    BOOST_REQUIRE_THROW(shm_ringbuffer<double> mismatch(name.c_str()), boost::system::system_error);
+}
+
+BOOST_AUTO_TEST_CASE( shm_ringbuffer_name_test )
+{
+    string name = segment_name("name");
+    shm_ringbuffer<int>::remove(name.c_str());
+
+    {
+        string buffer = name;
+        shm_ringbuffer<int> producer(buffer.c_str(), 64);
+
+        /* the ringbuffer has to unlink the segment, which it has created, not what the buffer contains later */
+        buffer = segment_name("other");
+    }
+
+    BOOST_REQUIRE(!shm_ringbuffer<int>::remove(name.c_str()));
+}
+
+BOOST_AUTO_TEST_CASE( shm_ringbuffer_corrupt_layout_test )
+{
+    string name = segment_name("corrupt");
+    shm_ringbuffer<int>::remove(name.c_str());
+
+    BOOST_REQUIRE_THROW(shm_ringbuffer<int> empty(name.c_str(), 0), boost::system::system_error);
+
+    shm_ringbuffer<int> producer(name.c_str(), 64);
+
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    BOOST_REQUIRE(fd != -1);
+    void * segment = ::mmap(NULL, sizeof(boost::lockfree::detail::shm_ringbuffer_header), PROT_READ | PROT_WRITE,
+                            MAP_SHARED, fd, 0);
+    ::close(fd);
+    BOOST_REQUIRE(segment != MAP_FAILED);
+
+    boost::lockfree::detail::shm_ringbuffer_header * h = static_cast<boost::lockfree::detail::shm_ringbuffer_header*>(segment);
+    const boost::uint64_t control_offset = h->control_offset;
+    const boost::uint64_t max_size = h->max_size;
+
+    /* control block overlaps the element storage */
+    h->control_offset = h->data_offset;
+    BOOST_REQUIRE_THROW(shm_ringbuffer<int> consumer(name.c_str()), boost::system::system_error);
+
+    /* misaligned control block */
+    h->control_offset = control_offset + 1;
+    BOOST_REQUIRE_THROW(shm_ringbuffer<int> consumer(name.c_str()), boost::system::system_error);
+    h->control_offset = control_offset;
+
+    h->max_size = 0;
+    BOOST_REQUIRE_THROW(shm_ringbuffer<int> consumer(name.c_str()), boost::system::system_error);
+
+    /* max_size * sizeof(int) wraps around */
+    h->max_size = boost::uint64_t(1) << 62;
+    BOOST_REQUIRE_THROW(shm_ringbuffer<int> consumer(name.c_str()), boost::system::system_error);
+    h->max_size = max_size;
+
+    shm_ringbuffer<int> consumer(name.c_str());
+    BOOST_REQUIRE(producer.enqueue(1));
+
+    int out = 0;
+    BOOST_REQUIRE(consumer.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 1);
+
+    ::munmap(segment, sizeof(boost::lockfree::detail::shm_ringbuffer_header));
+}
+
+static const int nodes_per_process = 500000;
+
+BOOST_AUTO_TEST_CASE( shm_ringbuffer_process_test )
+{
+    string name = segment_name("process");
+    shm_ringbuffer<int>::remove(name.c_str());
+
+    shm_ringbuffer<int> consumer(name.c_str(), 128);
+
+    pid_t child = ::fork();
+    BOOST_REQUIRE(child != -1);
+
+    if (child == 0) {
+        shm_ringbuffer<int> producer(name.c_str());
+
+        for (int i = 0; i != nodes_per_process; ++i)
+            while (!producer.enqueue(i))
+            {}
+        ::_exit(0);
+    }
+
+    int expected = 0;
+    while (expected != nodes_per_process) {
+        int data;
+        if (consumer.dequeue(&data)) {
+            BOOST_REQUIRE_EQUAL(data, expected);
+            ++expected;
+        }
+    }
+
+    int status;
+    BOOST_REQUIRE_EQUAL(::waitpid(child, &status, 0), child);
+    BOOST_REQUIRE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    BOOST_REQUIRE(consumer.empty());
+}
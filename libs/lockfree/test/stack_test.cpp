@@ -7,6 +7,7 @@
 #include <boost/lockfree/stack.hpp>
 
 #include <boost/thread.hpp>
+#include <vector>
 using namespace boost;
 
 template <typename freelist_t>
@@ -51,6 +52,8 @@ struct stack_tester
         {
             long id;
 
+            /* sample the flag before popping, so a pop failing before the last push cannot end the reader */
+            bool still_running = running;
             bool got = stk.pop(&id);
             if (got)
             {
@@ -59,7 +62,7 @@ struct stack_tester
                 ++pop_count;
             }
             else
-                if (not running)
+                if (not still_running)
                     return;
         }
     }
@@ -113,3 +116,71 @@ BOOST_AUTO_TEST_CASE( stack_test_static )
     stack_tester<boost::lockfree::static_freelist_t> tester;
     tester.run();
 }
+
+BOOST_AUTO_TEST_CASE( stack_test_inline_storage )
+{
+    stack_tester<boost::lockfree::capacity<1024> > tester;
+    tester.run();
+}
+
+BOOST_AUTO_TEST_CASE( stack_shared_pool_test )
+{
+    boost::lockfree::stack<long, boost::lockfree::shared_freelist_t>::pool_type pool(16);
+
+    boost::lockfree::stack<long, boost::lockfree::shared_freelist_t> s1(pool);
+    boost::lockfree::stack<long, boost::lockfree::shared_freelist_t> s2(pool);
+
+    for (long i = 0; i != 64; ++i) {
+        BOOST_REQUIRE(s1.push(i));
+        BOOST_REQUIRE(s2.push(-i));
+    }
+
+    for (long i = 63; i >= 0; --i) {
+        long out;
+        BOOST_REQUIRE(s1.pop(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+        BOOST_REQUIRE(s2.pop(&out));
+        BOOST_REQUIRE_EQUAL(out, -i);
+    }
+    BOOST_REQUIRE(s1.empty());
+    BOOST_REQUIRE(s2.empty());
+}
+
+template <typename stack_type>
+void test_unsynchronized_stack(stack_type & s)
+{
+    BOOST_REQUIRE(s.unsynchronized_push(0));
+
+    long in[62];
+    for (long i = 0; i != 62; ++i)
+        in[i] = i + 1;
+    BOOST_REQUIRE(s.unsynchronized_push(in, in + 62) == in + 62);
+
+    /* the unsynchronized and the synchronized operations can be mixed */
+    BOOST_REQUIRE(s.push(63));
+    long out;
+    BOOST_REQUIRE(s.unsynchronized_pop(&out));
+    BOOST_REQUIRE_EQUAL(out, 63);
+    BOOST_REQUIRE(s.push(63));
+
+    std::vector<long> drained;
+    BOOST_REQUIRE_EQUAL(s.unsynchronized_pop_all(std::back_inserter(drained)), 64u);
+    for (long i = 0; i != 64; ++i)
+        BOOST_REQUIRE_EQUAL(drained[i], 63 - i);
+
+    BOOST_REQUIRE(!s.pop(&out));
+    BOOST_REQUIRE(s.empty());
+}
+
+BOOST_AUTO_TEST_CASE( stack_unsynchronized_test )
+{
+    boost::lockfree::stack<long> s(16);
+    test_unsynchronized_stack(s);
+
+    boost::lockfree::stack<long, boost::lockfree::capacity<64> > fixed;
+    test_unsynchronized_stack(fixed);
+
+    /* a range, which exceeds the capacity, is pushed partially */
+    long in[128] = {0};
+    BOOST_REQUIRE(fixed.unsynchronized_push(in, in + 128) == in + 64);
+}
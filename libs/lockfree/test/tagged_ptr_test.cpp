@@ -1,4 +1,6 @@
+#include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
+#include <boost/lockfree/detail/tagged_ptr_pair.hpp>
 
 #include <climits>
 #define BOOST_TEST_MODULE lockfree_tests
@@ -28,3 +30,47 @@ BOOST_AUTO_TEST_CASE( tagged_ptr_test )
     }
 
 }
+
+BOOST_AUTO_TEST_CASE( atomic_tagged_ptr_test )
+{
+    using namespace boost::lockfree;
+    int a(1), b(2);
+
+    detail::atomic<tagged_ptr<int> > i(tagged_ptr<int>(&a, 0));
+    BOOST_REQUIRE(i.is_lock_free());
+    BOOST_REQUIRE_EQUAL(sizeof(i), sizeof(tagged_ptr<int>));
+
+    tagged_ptr<int> expected(&b, 0);
+    BOOST_REQUIRE(!i.compare_exchange_strong(expected, tagged_ptr<int>(&b, 1)));
+    BOOST_REQUIRE_EQUAL(expected.get_ptr(), &a);
+
+    BOOST_REQUIRE(i.compare_exchange_strong(expected, tagged_ptr<int>(&b, 1)));
+    BOOST_REQUIRE_EQUAL(i.load().get_ptr(), &b);
+    BOOST_REQUIRE_EQUAL(i.load().get_tag(), 1);
+
+    tagged_ptr<int> old = i.exchange(tagged_ptr<int>(&a, 2));
+    BOOST_REQUIRE_EQUAL(old.get_ptr(), &b);
+    BOOST_REQUIRE_EQUAL(i.load().get_tag(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( atomic_tagged_ptr_pair_test )
+{
+    using namespace boost::lockfree;
+    typedef tagged_ptr_pair<int, int> pair;
+    int a(1), b(2);
+
+    detail::atomic<pair> i(pair(&a, &b, 1, 2));
+    BOOST_REQUIRE(i.is_lock_free());
+
+    pair expected = i.load();
+    BOOST_REQUIRE(i.compare_exchange_strong(expected, pair(&b, &a, 3, 4)));
+
+    pair current = i.load();
+    BOOST_REQUIRE_EQUAL(current.get_left_ptr(), &b);
+    BOOST_REQUIRE_EQUAL(current.get_right_ptr(), &a);
+    BOOST_REQUIRE_EQUAL(current.get_left_tag(), 3);
+    BOOST_REQUIRE_EQUAL(current.get_right_tag(), 4);
+
+    BOOST_REQUIRE(!i.compare_exchange_strong(expected, pair(&a, &a, 5, 6)));
+    BOOST_REQUIRE(expected == current);
+}
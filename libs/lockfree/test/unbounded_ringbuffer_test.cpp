@@ -0,0 +1,102 @@
+#include <boost/lockfree/unbounded_ringbuffer.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( simple_unbounded_ringbuffer_test )
+{
+    unbounded_ringbuffer<int, 4> f;
+
+    BOOST_REQUIRE(f.empty());
+    f.enqueue(1);
+    f.enqueue(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.dequeue(&i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.dequeue(&i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( unbounded_ringbuffer_segments_test )
+{
+    unbounded_ringbuffer<int, 4> f;
+
+    /* spans several segments */
+    for (int i = 0; i != 100; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+
+    for (int i = 0; i != 100; ++i) {
+        int out;
+        BOOST_REQUIRE(f.dequeue(&out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+
+    int out;
+    BOOST_REQUIRE(!f.dequeue(&out));
+    BOOST_REQUIRE(f.empty());
+
+    /* exactly at a segment boundary */
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(f.enqueue(i));
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(!f.dequeue(&out));
+
+    BOOST_REQUIRE(f.enqueue(42));
+    BOOST_REQUIRE(!f.empty());
+    BOOST_REQUIRE(f.dequeue(&out));
+    BOOST_REQUIRE_EQUAL(out, 42);
+}
+
+static const int nodes_per_thread = 1000000;
+
+struct unbounded_ringbuffer_tester
+{
+    unbounded_ringbuffer<int, 64> sf;
+
+    void add(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i)
+            BOOST_REQUIRE(sf.enqueue(i));
+    }
+
+    void get(void)
+    {
+        for (int i = 0; i != nodes_per_thread; ++i) {
+            int data;
+            while (!sf.dequeue(&data))
+                boost::this_thread::yield();
+            BOOST_REQUIRE_EQUAL(data, i);
+        }
+    }
+
+    void run(void)
+    {
+        thread reader(boost::bind(&unbounded_ringbuffer_tester::get, this));
+        thread writer(boost::bind(&unbounded_ringbuffer_tester::add, this));
+
+        writer.join();
+        reader.join();
+
+        BOOST_REQUIRE(sf.empty());
+    }
+};
+
+BOOST_AUTO_TEST_CASE( unbounded_ringbuffer_test )
+{
+    unbounded_ringbuffer_tester test1;
+    test1.run();
+}
@@ -0,0 +1,148 @@
+#include <boost/lockfree/work_stealing_deque.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/scoped_array.hpp>
+#include <boost/thread.hpp>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+
+BOOST_AUTO_TEST_CASE( simple_work_stealing_deque_test )
+{
+    work_stealing_deque<int> d(4);
+
+    BOOST_WARN(d.is_lock_free());
+    BOOST_REQUIRE(d.empty());
+
+    int out;
+    BOOST_REQUIRE(!d.pop_bottom(out));
+    BOOST_REQUIRE(!d.steal(out));
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(d.push_bottom(i));
+
+    /* the owner pops the newest, thieves steal the oldest element */
+    BOOST_REQUIRE(d.pop_bottom(out));
+    BOOST_REQUIRE_EQUAL(out, 3);
+    BOOST_REQUIRE(d.steal(out));
+    BOOST_REQUIRE_EQUAL(out, 0);
+    BOOST_REQUIRE(d.steal(&out));
+    BOOST_REQUIRE_EQUAL(out, 1);
+    BOOST_REQUIRE(d.pop_bottom(&out));
+    BOOST_REQUIRE_EQUAL(out, 2);
+
+    BOOST_REQUIRE(!d.pop_bottom(out));
+    BOOST_REQUIRE(!d.steal(out));
+    BOOST_REQUIRE(d.empty());
+}
+
+BOOST_AUTO_TEST_CASE( work_stealing_deque_grow_test )
+{
+    work_stealing_deque<int> d(2);
+
+    /* steal some elements, so that the live range wraps around when the array is grown */
+    for (int i = 0; i != 2; ++i)
+        BOOST_REQUIRE(d.push_bottom(i));
+    int out;
+    BOOST_REQUIRE(d.steal(out));
+
+    for (int i = 2; i != 1000; ++i)
+        BOOST_REQUIRE(d.push_bottom(i));
+
+    for (int i = 1; i != 500; ++i) {
+        BOOST_REQUIRE(d.steal(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    for (int i = 999; i != 499; --i) {
+        BOOST_REQUIRE(d.pop_bottom(out));
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+    BOOST_REQUIRE(d.empty());
+}
+
+BOOST_AUTO_TEST_CASE( work_stealing_deque_static_test )
+{
+    work_stealing_deque<int, static_freelist_t> d(4);
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(d.push_bottom(i));
+    BOOST_REQUIRE(!d.push_bottom(4));
+
+    int out;
+    BOOST_REQUIRE(d.steal(out));
+    BOOST_REQUIRE(d.push_bottom(4));
+}
+
+struct work_stealing_deque_tester
+{
+    static const int elements = 1000000;
+    static const int thief_count = 3;
+
+    work_stealing_deque<int> d;
+    scoped_array<boost::atomic<int> > received;
+    boost::atomic<bool> running;
+
+    work_stealing_deque_tester(void):
+        d(16), received(new boost::atomic<int>[elements]), running(true)
+    {
+        for (int i = 0; i != elements; ++i)
+            received[i].store(0);
+    }
+
+    void thief(void)
+    {
+        int out;
+        for (;;) {
+            bool still_running = running.load();
+            if (d.steal(out))
+                ++received[out];
+            else if (!still_running)
+                return;
+            else
+                boost::this_thread::yield();
+        }
+    }
+
+    /* the owner pushes bursts of elements and pops some of them itself */
+    void owner(void)
+    {
+        int out;
+        for (int i = 0; i != elements;) {
+            for (int j = 0; j != 64 && i != elements; ++j, ++i)
+                BOOST_REQUIRE(d.push_bottom(i));
+
+            for (int j = 0; j != 16; ++j)
+                if (d.pop_bottom(out))
+                    ++received[out];
+        }
+
+        while (d.pop_bottom(out))
+            ++received[out];
+    }
+
+    void run(void)
+    {
+        thread_group thieves;
+        for (int i = 0; i != thief_count; ++i)
+            thieves.create_thread(boost::bind(&work_stealing_deque_tester::thief, this));
+
+        owner();
+        running = false;
+        thieves.join_all();
+
+        BOOST_REQUIRE(d.empty());
+        for (int i = 0; i != elements; ++i)
+            BOOST_REQUIRE_EQUAL(received[i].load(), 1);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( work_stealing_deque_test )
+{
+    work_stealing_deque_tester test1;
+    test1.run();
+}
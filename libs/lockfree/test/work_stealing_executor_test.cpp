@@ -0,0 +1,167 @@
+#include <boost/lockfree/work_stealing_executor.hpp>
+
+#include <climits>
+#define BOOST_TEST_MODULE lockfree_tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <boost/scoped_array.hpp>
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+typedef work_stealing_executor::task task;
+typedef work_stealing_executor::task_group task_group;
+
+struct counting_task:
+    task
+{
+    boost::atomic<int> * counter;
+
+    void execute(void)
+    {
+        ++*counter;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( simple_work_stealing_executor_test )
+{
+    work_stealing_executor executor(4);
+    BOOST_REQUIRE_EQUAL(executor.thread_count(), 4U);
+
+    const int task_count = 1000;
+    boost::atomic<int> counter(0);
+    scoped_array<counting_task> tasks(new counting_task[task_count]);
+
+    task_group group;
+    for (int i = 0; i != task_count; ++i) {
+        tasks[i].counter = &counter;
+        executor.spawn(tasks[i], group);
+    }
+
+    executor.wait(group);
+    BOOST_REQUIRE(group.done());
+    BOOST_REQUIRE_EQUAL(counter.load(), task_count);
+}
+
+static const unsigned int fib_cutoff = 20;
+
+static unsigned long serial_fib(unsigned int n)
+{
+    return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+}
+
+/* the child tasks live on the stack of their parent, spawning does not allocate */
+struct fib_task:
+    task
+{
+    work_stealing_executor & executor;
+    unsigned int n;
+    unsigned long * result;
+
+    fib_task(work_stealing_executor & executor, unsigned int n, unsigned long * result):
+        executor(executor), n(n), result(result)
+    {}
+
+    void execute(void)
+    {
+        if (n < fib_cutoff) {
+            *result = serial_fib(n);
+            return;
+        }
+
+        unsigned long x, y;
+        fib_task left(executor, n - 1, &x);
+        fib_task right(executor, n - 2, &y);
+
+        task_group group;
+        executor.spawn(left, group);
+        right.execute();
+        executor.wait(group);
+
+        *result = x + y;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( work_stealing_executor_fib_test )
+{
+    const unsigned int n = 30;
+    const unsigned long expected = serial_fib(n);
+
+    for (std::size_t threads = 1; threads <= 4; threads *= 2) {
+        work_stealing_executor executor(threads);
+
+        unsigned long result = 0;
+        fib_task root(executor, n, &result);
+        task_group group;
+
+        executor.spawn(root, group);
+        executor.wait(group);
+
+        BOOST_REQUIRE_EQUAL(result, expected);
+    }
+}
+
+static const std::size_t reduce_grain = 4096;
+
+/* recursively splits the range until it is smaller than the grain size */
+struct reduce_task:
+    task
+{
+    work_stealing_executor & executor;
+    const int * begin;
+    const int * end;
+    long long * result;
+
+    reduce_task(work_stealing_executor & executor, const int * begin, const int * end, long long * result):
+        executor(executor), begin(begin), end(end), result(result)
+    {}
+
+    void execute(void)
+    {
+        if (std::size_t(end - begin) <= reduce_grain) {
+            long long sum = 0;
+            for (const int * it = begin; it != end; ++it)
+                sum += *it;
+            *result = sum;
+            return;
+        }
+
+        const int * middle = begin + (end - begin) / 2;
+        long long x, y;
+        reduce_task left(executor, begin, middle, &x);
+        reduce_task right(executor, middle, end, &y);
+
+        task_group group;
+        executor.spawn(left, group);
+        right.execute();
+        executor.wait(group);
+
+        *result = x + y;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( work_stealing_executor_reduce_test )
+{
+    const std::size_t size = 1 << 20;
+    vector<int> data(size);
+    long long expected = 0;
+    for (std::size_t i = 0; i != size; ++i) {
+        data[i] = int(i % 1000);
+        expected += data[i];
+    }
+
+    for (std::size_t threads = 1; threads <= 4; threads *= 2) {
+        work_stealing_executor executor(threads);
+
+        long long result = 0;
+        reduce_task root(executor, &data[0], &data[0] + size, &result);
+        task_group group;
+
+        executor.spawn(root, group);
+        executor.wait(group);
+
+        BOOST_REQUIRE_EQUAL(result, expected);
+    }
+}